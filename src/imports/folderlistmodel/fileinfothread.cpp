@@ -41,6 +41,8 @@
 
 #include "fileinfothread_p.h"
 #include <qdiriterator.h>
+#include <QHash>
+#include <QVector>
 
 #include <QDebug>
 
@@ -254,67 +256,107 @@ void FileInfoThread::getFileInfos(const QString &path)
 
     fileInfoList = currentDir.entryInfoList(nameFilters, filter, sortFlags);
 
-    if (!fileInfoList.isEmpty()) {
-        foreach (QFileInfo info, fileInfoList) {
-            //qDebug() << "Adding file : " << info.fileName() << "to list ";
-            filePropertyList << FileProperty(info);
-        }
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            findChangeRange(filePropertyList, fromIndex, toIndex);
-            folderUpdate = false;
-            currentFileList = filePropertyList;
-            //qDebug() << "emit directoryUpdated : " << fromIndex << " " << toIndex;
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList = filePropertyList;
-            if (sortUpdate) {
-                emit sortFinished(filePropertyList);
-                sortUpdate = false;
-            } else
-                emit directoryChanged(path, filePropertyList);
-        }
+    filePropertyList.reserve(fileInfoList.size());
+    foreach (QFileInfo info, fileInfoList) {
+        //qDebug() << "Adding file : " << info.fileName() << "to list ";
+        filePropertyList << FileProperty(info);
+    }
+    if (folderUpdate) {
+        QList<QPair<int, int> > removed;
+        QList<QPair<int, int> > inserted;
+        QList<QPair<int, int> > changed;
+        findChanges(filePropertyList, &removed, &inserted, &changed);
+        folderUpdate = false;
+        currentFileList = filePropertyList;
+        emit directoryUpdated(path, filePropertyList, removed, inserted, changed);
     } else {
-        // The directory is empty
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            folderUpdate = false;
-            currentFileList.clear();
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList.clear();
+        currentFileList = filePropertyList;
+        if (sortUpdate) {
+            emit sortFinished(filePropertyList);
+            sortUpdate = false;
+        } else
             emit directoryChanged(path, filePropertyList);
-        }
     }
     needUpdate = false;
 }
 
-void FileInfoThread::findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex)
+static void appendRange(QList<QPair<int, int> > *ranges, int index)
 {
-    if (currentFileList.size() == 0) {
-        fromIndex = 0;
-        toIndex = list.size();
-        return;
-    }
+    if (!ranges->isEmpty() && ranges->last().first + ranges->last().second == index)
+        ++ranges->last().second;
+    else
+        ranges->append(qMakePair(index, 1));
+}
 
-    int i;
-    int listSize = list.size() < currentFileList.size() ? list.size() : currentFileList.size();
-    bool changeFound = false;
+/*
+    Compares \a list against the current file list and returns the differences as
+    (index, count) ranges: \a removed indexes the current list, \a inserted and \a changed
+    index \a list.  Files present in both lists keep their place unless they were moved by
+    the sort; the largest set of files whose relative order is unchanged is kept, and the
+    others are reported as removed and inserted again.
+*/
+void FileInfoThread::findChanges(const QList<FileProperty> &list, QList<QPair<int, int> > *removed,
+                                 QList<QPair<int, int> > *inserted, QList<QPair<int, int> > *changed) const
+{
+    const int oldCount = currentFileList.count();
+    const int newCount = list.count();
+
+    QHash<QString, int> oldIndexes;
+    oldIndexes.reserve(oldCount);
+    for (int i = 0; i < oldCount; ++i)
+        oldIndexes.insert(currentFileList.at(i).fileName(), i);
+
+    // The index in the current list of each new entry, or -1 for new files.
+    QVector<int> sources(newCount, -1);
+    for (int i = 0; i < newCount; ++i) {
+        QHash<QString, int>::const_iterator it = oldIndexes.constFind(list.at(i).fileName());
+        if (it != oldIndexes.constEnd() && currentFileList.at(*it) == list.at(i))
+            sources[i] = *it;
+    }
 
-    for (i=0; i < listSize; i++) {
-        if (list.at(i) != currentFileList.at(i)) {
-            changeFound = true;
-            break;
+    // Longest increasing run of sources, which are the entries that can stay in place.
+    QVector<int> tails;         // new index of the smallest tail of a run of each length
+    QVector<int> previous(newCount, -1);
+    for (int i = 0; i < newCount; ++i) {
+        const int source = sources.at(i);
+        if (source < 0)
+            continue;
+        int low = 0;
+        int high = tails.count();
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (sources.at(tails.at(middle)) < source)
+                low = middle + 1;
+            else
+                high = middle;
         }
+        if (low > 0)
+            previous[i] = tails.at(low - 1);
+        if (low == tails.count())
+            tails.append(i);
+        else
+            tails[low] = i;
     }
 
-    if (changeFound)
-        fromIndex = i;
-    else
-        fromIndex = i-1;
+    QVector<bool> keptOld(oldCount, false);
+    QVector<bool> keptNew(newCount, false);
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous.at(i)) {
+        keptNew[i] = true;
+        keptOld[sources.at(i)] = true;
+    }
 
-    // For now I let the rest of the list be updated..
-    toIndex = list.size() > currentFileList.size() ? list.size() - 1 : currentFileList.size() - 1;
+    for (int i = 0; i < oldCount; ++i) {
+        if (!keptOld.at(i))
+            appendRange(removed, i);
+    }
+    for (int i = 0; i < newCount; ++i) {
+        if (!keptNew.at(i)) {
+            appendRange(inserted, i);
+        } else {
+            const FileProperty &oldProperty = currentFileList.at(sources.at(i));
+            const FileProperty &newProperty = list.at(i);
+            if (oldProperty.statChanged(newProperty))
+                appendRange(changed, i);
+        }
+    }
 }
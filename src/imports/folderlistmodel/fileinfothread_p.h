@@ -48,6 +48,7 @@
 #include <QFileSystemWatcher>
 #include <QFileInfo>
 #include <QDir>
+#include <QPair>
 
 #include "fileproperty_p.h"
 
@@ -57,7 +58,10 @@ class FileInfoThread : public QThread
 
 Q_SIGNALS:
     void directoryChanged(const QString &directory, const QList<FileProperty> &list) const;
-    void directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex) const;
+    void directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                          const QList<QPair<int, int> > &removed,
+                          const QList<QPair<int, int> > &inserted,
+                          const QList<QPair<int, int> > &changed) const;
     void sortFinished(const QList<FileProperty> &list) const;
 
 public:
@@ -86,7 +90,8 @@ public Q_SLOTS:
 protected:
     void run();
     void getFileInfos(const QString &path);
-    void findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex);
+    void findChanges(const QList<FileProperty> &list, QList<QPair<int, int> > *removed,
+                     QList<QPair<int, int> > *inserted, QList<QPair<int, int> > *changed) const;
 
 private:
     QMutex mutex;
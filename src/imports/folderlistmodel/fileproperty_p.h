@@ -73,6 +73,12 @@ public:
     inline QDateTime lastModified() const { return mLastModified; }
     inline QDateTime lastRead() const { return mLastRead; }
 
+    bool statChanged(const FileProperty &property) const
+    {
+        return mSize != property.mSize || mLastModified != property.mLastModified
+                || mLastRead != property.mLastRead;
+    }
+
     inline bool operator !=(const FileProperty &fileInfo) const {
         return !operator==(fileInfo);
     }
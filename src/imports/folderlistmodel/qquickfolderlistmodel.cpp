@@ -85,7 +85,10 @@ public:
 
     // private slots
     void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list);
-    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex);
+    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                             const QList<QPair<int, int> > &removed,
+                             const QList<QPair<int, int> > &inserted,
+                             const QList<QPair<int, int> > &changed);
     void _q_sortFinished(const QList<FileProperty> &list);
 
     static QString resolvePath(const QUrl &path);
@@ -96,10 +99,11 @@ void QQuickFolderListModelPrivate::init()
 {
     Q_Q(QQuickFolderListModel);
     qRegisterMetaType<QList<FileProperty> >("QList<FileProperty>");
+    qRegisterMetaType<QList<QPair<int, int> > >("QList<QPair<int,int> >");
     q->connect(&fileInfoThread, SIGNAL(directoryChanged(QString, QList<FileProperty>)),
                q, SLOT(_q_directoryChanged(QString, QList<FileProperty>)));
-    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString, QList<FileProperty>, int, int)),
-               q, SLOT(_q_directoryUpdated(QString, QList<FileProperty>, int, int)));
+    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString, QList<FileProperty>, QList<QPair<int,int> >, QList<QPair<int,int> >, QList<QPair<int,int> >)),
+               q, SLOT(_q_directoryUpdated(QString, QList<FileProperty>, QList<QPair<int,int> >, QList<QPair<int,int> >, QList<QPair<int,int> >)));
     q->connect(&fileInfoThread, SIGNAL(sortFinished(QList<FileProperty>)),
                q, SLOT(_q_sortFinished(QList<FileProperty>)));
     q->connect(q, SIGNAL(rowCountChanged()), q, SIGNAL(countChanged()));
@@ -152,42 +156,48 @@ void QQuickFolderListModelPrivate::_q_directoryChanged(const QString &directory,
 }
 
 
-void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex)
+void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &list,
+                                                       const QList<QPair<int, int> > &removed,
+                                                       const QList<QPair<int, int> > &inserted,
+                                                       const QList<QPair<int, int> > &changed)
 {
     Q_Q(QQuickFolderListModel);
-    Q_UNUSED(directory);
+
+    // The folder was changed after the thread sent this; the new listing is on its way.
+    if (directory != resolvePath(currentDir))
+        return;
 
     QModelIndex parent;
-    if (data.size() > list.size()) {
-        //File(s) removed. Since I do not know how many
-        //or where I need to update the whole list from the first item.
-        data = list;
-        q->beginRemoveRows(parent, fromIndex, toIndex);
+    const int previousCount = data.count();
+
+    // Removed ranges index the old list; taking them from the end keeps the others valid.
+    for (int i = removed.count() - 1; i >= 0; --i) {
+        const QPair<int, int> &range = removed.at(i);
+        q->beginRemoveRows(parent, range.first, range.first + range.second - 1);
+        data.erase(data.begin() + range.first, data.begin() + range.first + range.second);
         q->endRemoveRows();
-        if (list.size() > 0) {
-            q->beginInsertRows(parent, fromIndex, list.size()-1);
-            q->endInsertRows();
-        }
-        emit q->rowCountChanged();
-    } else if (data.size() < list.size()) {
-        //qDebug() << "File added. FromIndex: " << fromIndex << " toIndex: " << toIndex << " list size: " << list.size();
-        //File(s) added. Calculate how many and insert
-        //from the first changed one.
-        toIndex = fromIndex + (list.size() - data.size()-1);
-        q->beginInsertRows(parent, fromIndex, toIndex);
+    }
+
+    // What is left is in the order of the new list, so the inserted ranges can be filled in
+    // from the start.
+    for (int i = 0; i < inserted.count(); ++i) {
+        const QPair<int, int> &range = inserted.at(i);
+        q->beginInsertRows(parent, range.first, range.first + range.second - 1);
+        for (int j = range.first; j < range.first + range.second; ++j)
+            data.insert(j, list.at(j));
         q->endInsertRows();
-        data = list;
-        emit q->rowCountChanged();
-        QModelIndex modelIndexFrom = q->createIndex(fromIndex, 0);
-        QModelIndex modelIndexTo = q->createIndex(toIndex, 0);
-        emit q->dataChanged(modelIndexFrom, modelIndexTo);
-    } else {
-        //qDebug() << "File has been updated";
-        QModelIndex modelIndexFrom = q->createIndex(fromIndex, 0);
-        QModelIndex modelIndexTo = q->createIndex(toIndex, 0);
-        data = list;
-        emit q->dataChanged(modelIndexFrom, modelIndexTo);
     }
+
+    for (int i = 0; i < changed.count(); ++i) {
+        const QPair<int, int> &range = changed.at(i);
+        for (int j = range.first; j < range.first + range.second; ++j)
+            data[j] = list.at(j);
+        emit q->dataChanged(q->createIndex(range.first, 0),
+                            q->createIndex(range.first + range.second - 1, 0));
+    }
+
+    if (data.count() != previousCount)
+        emit q->rowCountChanged();
 }
 
 void QQuickFolderListModelPrivate::_q_sortFinished(const QList<FileProperty> &list)
@@ -283,6 +293,16 @@ QString QQuickFolderListModelPrivate::resolvePath(const QUrl &path)
     that the user can access. The \l showOnlyReadable property can be set to
     enable this feature.
 
+    \section1 Updates
+
+    The folder is read in a background thread.  When its contents change, only the
+    files that were added or removed are inserted into or removed from the model,
+    and the delegates of the other files are kept.
+
+    The \c fileSize, \c fileModified and \c fileAccessed roles are read along with
+    the listing, so they are valid as soon as a file is in the model.  The delegates
+    of the files whose size or times changed are notified through these roles.
+
     \section1 Example Usage
 
     The following example shows a FolderListModel being used to provide a list
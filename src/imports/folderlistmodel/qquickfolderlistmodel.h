@@ -164,7 +164,7 @@ private:
     QScopedPointer<QQuickFolderListModelPrivate> d_ptr;
 
     Q_PRIVATE_SLOT(d_func(), void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list))
-    Q_PRIVATE_SLOT(d_func(), void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex))
+    Q_PRIVATE_SLOT(d_func(), void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, const QList<QPair<int, int> > &removed, const QList<QPair<int, int> > &inserted, const QList<QPair<int, int> > &changed))
     Q_PRIVATE_SLOT(d_func(), void _q_sortFinished(const QList<FileProperty> &list))
 };
 //![class end]
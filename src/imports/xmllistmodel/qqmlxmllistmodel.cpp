@@ -55,11 +55,13 @@
 #include <QXmlQuery>
 #include <QXmlResultItems>
 #include <QXmlNodeModelIndex>
+#include <QXmlStreamReader>
 #include <QBuffer>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QTimer>
 #include <QMutex>
+#include <qnumeric.h>
 
 #include <private/qabstractitemmodel_p.h>
 
@@ -72,6 +74,7 @@ using namespace QV4;
 typedef QPair<int, int> QQuickXmlListRange;
 
 #define XMLLISTMODEL_CLEAR_ID 0
+#define XMLLISTMODEL_STREAM_CHUNK_SIZE 1000
 
 /*!
     \qmlmodule QtQuick.XmlListModel 2
@@ -152,6 +155,19 @@ typedef QPair<int, int> QQuickXmlListRange;
     \sa XmlListModel
 */
 
+// A role query of the form "path/to/element/string()", "path/to/@attribute/string()" or the
+// same with number(), which can be evaluated while streaming through the document.
+struct XmlStreamRole
+{
+    enum Type { Invalid, String, Number };
+
+    XmlStreamRole() : type(Invalid) {}
+
+    Type type;
+    QStringList path;       // the elements leading to the value, relative to the item
+    QString attribute;      // if set, the value is this attribute of the last element in path
+};
+
 struct XmlQueryJob
 {
     int queryId;
@@ -163,8 +179,78 @@ struct XmlQueryJob
     QStringList keyRoleQueries;
     QStringList keyRoleResultsCache;
     QString prefix;
+
+    // Set if the query and all role queries are simple paths that can be evaluated in a
+    // single pass with QXmlStreamReader instead of with QXmlQuery.
+    bool streaming;
+    QStringList streamQuery;
+    QList<XmlStreamRole> streamRoles;
+    QList<int> streamKeyRoles;
 };
 
+static bool isStreamName(const QString &name)
+{
+    // Unprefixed element or attribute names only; anything else needs QXmlQuery.
+    if (name.isEmpty())
+        return false;
+    for (int i = 0; i < name.length(); ++i) {
+        const QChar c = name.at(i);
+        if (c.isLetter() || c == QLatin1Char('_'))
+            continue;
+        if (i > 0 && (c.isDigit() || c == QLatin1Char('-') || c == QLatin1Char('.')))
+            continue;
+        return false;
+    }
+    return true;
+}
+
+static bool parseStreamQuery(const QString &query, QStringList *path)
+{
+    if (!query.startsWith(QLatin1Char('/')))
+        return false;
+    const QStringList steps = query.mid(1).split(QLatin1Char('/'));
+    foreach (const QString &step, steps) {
+        if (!isStreamName(step))
+            return false;
+    }
+    *path = steps;
+    return true;
+}
+
+static bool parseStreamRole(const QString &query, XmlStreamRole *role)
+{
+    static const QString stringFunction = QStringLiteral("string()");
+    static const QString numberFunction = QStringLiteral("number()");
+
+    QString path;
+    if (query.endsWith(stringFunction))
+        role->type = XmlStreamRole::String;
+    else if (query.endsWith(numberFunction))
+        role->type = XmlStreamRole::Number;
+    else
+        return false;
+
+    path = query.left(query.length() - stringFunction.length());
+    if (path.isEmpty())
+        return true;
+    if (!path.endsWith(QLatin1Char('/')))
+        return false;
+    path.chop(1);
+
+    QStringList steps = path.split(QLatin1Char('/'));
+    if (steps.last().startsWith(QLatin1Char('@'))) {
+        role->attribute = steps.takeLast().mid(1);
+        if (!isStreamName(role->attribute))
+            return false;
+    }
+    foreach (const QString &step, steps) {
+        if (!isStreamName(step))
+            return false;
+    }
+    role->path = steps;
+    return true;
+}
+
 
 class QQuickXmlQueryEngine;
 class QQuickXmlQueryThreadObject : public QObject
@@ -206,7 +292,9 @@ private:
     void processQuery(XmlQueryJob *job);
     void doQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void doSubQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
+    bool doStreamingJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void getValuesOfKeyRoles(const XmlQueryJob& currentJob, QStringList *values, QXmlQuery *query) const;
+    void compareKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const;
     void addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const;
 
     QMutex m_mutex;
@@ -282,16 +370,25 @@ int QQuickXmlQueryEngine::doQuery(QString query, QString namespaces, QByteArray
     job.query = QLatin1String("doc($src)") + query;
     job.namespaces = namespaces;
     job.keyRoleResultsCache = keyRoleResultsCache;
+    job.streaming = namespaces.trimmed().isEmpty() && parseStreamQuery(query, &job.streamQuery);
 
     for (int i=0; i<roleObjects->count(); i++) {
         if (!roleObjects->at(i)->isValid()) {
             job.roleQueries << QString();
+            job.streamRoles << XmlStreamRole();
             continue;
         }
         job.roleQueries << roleObjects->at(i)->query();
         job.roleQueryErrorId << static_cast<void*>(roleObjects->at(i));
-        if (roleObjects->at(i)->isKey())
+        if (roleObjects->at(i)->isKey()) {
             job.keyRoleQueries << job.roleQueries.last();
+            job.streamKeyRoles << i;
+        }
+
+        XmlStreamRole role;
+        if (job.streaming && !parseStreamRole(job.roleQueries.last(), &role))
+            job.streaming = false;
+        job.streamRoles << role;
     }
 
     {
@@ -362,8 +459,13 @@ void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
 {
     QQuickXmlQueryResult result;
     result.queryId = job->queryId;
-    doQueryJob(job, &result);
-    doSubQueryJob(job, &result);
+    if (job->streaming) {
+        if (!doStreamingJob(job, &result))
+            return;
+    } else {
+        doQueryJob(job, &result);
+        doSubQueryJob(job, &result);
+    }
 
     {
         QMutexLocker ml(&m_mutex);
@@ -434,6 +536,31 @@ void QQuickXmlQueryEngine::getValuesOfKeyRoles(const XmlQueryJob& currentJob, QS
     }
 }
 
+void QQuickXmlQueryEngine::compareKeyRoleResults(const XmlQueryJob &currentJob, const QStringList &keyRoleResults, QQuickXmlQueryResult *currentResult) const
+{
+    // See if any values of key roles have been inserted or removed.
+
+    if (currentJob.keyRoleResultsCache.isEmpty()) {
+        currentResult->inserted << qMakePair(0, currentResult->size);
+    } else if (keyRoleResults != currentJob.keyRoleResultsCache) {
+        const QSet<QString> newKeys = keyRoleResults.toSet();
+        QStringList kept;
+        for (int i=0; i<currentJob.keyRoleResultsCache.count(); i++) {
+            if (!newKeys.contains(currentJob.keyRoleResultsCache[i]))
+                addIndexToRangeList(&currentResult->removed, i);
+            else
+                kept << currentJob.keyRoleResultsCache[i];
+        }
+        // Every new key that doesn't continue the sequence of kept keys is an insertion.
+        for (int i=0, k=0; i<keyRoleResults.count(); i++) {
+            if (k < kept.count() && keyRoleResults[i] == kept[k])
+                ++k;
+            else
+                addIndexToRangeList(&currentResult->inserted, i);
+        }
+    }
+}
+
 void QQuickXmlQueryEngine::addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const {
     if (ranges->isEmpty())
         ranges->append(qMakePair(index, 1));
@@ -456,27 +583,7 @@ void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQuery
     QStringList keyRoleResults;
     getValuesOfKeyRoles(*currentJob, &keyRoleResults, &subquery);
 
-    // See if any values of key roles have been inserted or removed.
-
-    if (currentJob->keyRoleResultsCache.isEmpty()) {
-        currentResult->inserted << qMakePair(0, currentResult->size);
-    } else {
-        if (keyRoleResults != currentJob->keyRoleResultsCache) {
-            QStringList temp;
-            for (int i=0; i<currentJob->keyRoleResultsCache.count(); i++) {
-                if (!keyRoleResults.contains(currentJob->keyRoleResultsCache[i]))
-                    addIndexToRangeList(&currentResult->removed, i);
-                else
-                    temp << currentJob->keyRoleResultsCache[i];
-            }
-            for (int i=0; i<keyRoleResults.count(); i++) {
-                if (temp.count() == i || keyRoleResults[i] != temp[i]) {
-                    temp.insert(i, keyRoleResults[i]);
-                    addIndexToRangeList(&currentResult->inserted, i);
-                }
-            }
-        }
-    }
+    compareKeyRoleResults(*currentJob, keyRoleResults, currentResult);
     currentResult->keyRoleResultsCache = keyRoleResults;
 
     // Get the new values for each role.
@@ -534,6 +641,184 @@ void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQuery
     }*/
 }
 
+namespace {
+
+struct XmlStreamRoleState
+{
+    XmlStreamRoleState() : matched(0), captureDepth(0), found(false) {}
+
+    int matched;        // the number of leading elements of the role path the reader is in
+    int captureDepth;   // the depth of the element whose text is being collected, or 0
+    bool found;
+    QString text;
+};
+
+}
+
+static QVariant streamRoleValue(const XmlStreamRole &role, const XmlStreamRoleState &state)
+{
+    // Mirrors the XQuery used otherwise, which gives an empty string for missing values.
+    if (role.type == XmlStreamRole::Invalid)
+        return QVariant();
+    if (!state.found)
+        return QVariant(QString(QLatin1String("")));
+    if (role.type == XmlStreamRole::Number) {
+        bool ok = false;
+        const double number = state.text.trimmed().toDouble(&ok);
+        return QVariant(ok ? number : qQNaN());
+    }
+    return QVariant(state.text);
+}
+
+// Evaluates the query of a streaming job with a single pass of QXmlStreamReader.  Without key
+// roles the rows are sent to the model in chunks as they are read, and currentResult holds the
+// rows following the last chunk.  Returns false if the job was cancelled while reading.
+bool QQuickXmlQueryEngine::doStreamingJob(XmlQueryJob *currentJob, QQuickXmlQueryResult *currentResult)
+{
+    Q_ASSERT(currentJob->queryId != -1);
+
+    const QStringList &itemPath = currentJob->streamQuery;
+    const QList<XmlStreamRole> &roles = currentJob->streamRoles;
+    const int itemDepth = itemPath.count();
+    const int roleCount = roles.count();
+    const bool chunked = currentJob->streamKeyRoles.isEmpty();
+
+    QVector<XmlStreamRoleState> states(roleCount);
+    QList<QList<QVariant> > data;
+    for (int i = 0; i < roleCount; ++i)
+        data << QList<QVariant>();
+    QStringList keyRoleResults;
+
+    int depth = 0;
+    int matched = 0;
+    int rows = 0;
+    int sent = 0;
+
+    QXmlStreamReader reader(currentJob->data);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement:
+            ++depth;
+            if (matched == itemDepth) {
+                const int relative = depth - itemDepth;
+                const bool unqualified = reader.namespaceUri().isEmpty();
+                for (int i = 0; i < roleCount; ++i) {
+                    const XmlStreamRole &role = roles.at(i);
+                    XmlStreamRoleState &state = states[i];
+                    if (state.found || state.captureDepth || state.matched != relative - 1
+                            || relative > role.path.count() || !unqualified
+                            || reader.name() != role.path.at(relative - 1)) {
+                        continue;
+                    }
+                    state.matched = relative;
+                    if (relative != role.path.count())
+                        continue;
+                    if (role.attribute.isEmpty()) {
+                        state.captureDepth = depth;
+                    } else if (reader.attributes().hasAttribute(QString(), role.attribute)) {
+                        state.text = reader.attributes().value(QString(), role.attribute).toString();
+                        state.found = true;
+                    }
+                }
+            } else if (matched == depth - 1 && depth <= itemDepth && reader.namespaceUri().isEmpty()
+                    && reader.name() == itemPath.at(depth - 1)) {
+                matched = depth;
+                if (matched == itemDepth) {
+                    for (int i = 0; i < roleCount; ++i) {
+                        const XmlStreamRole &role = roles.at(i);
+                        XmlStreamRoleState &state = states[i];
+                        state = XmlStreamRoleState();
+                        if (role.type == XmlStreamRole::Invalid || !role.path.isEmpty())
+                            continue;
+                        if (role.attribute.isEmpty()) {
+                            state.captureDepth = depth;
+                        } else if (reader.attributes().hasAttribute(QString(), role.attribute)) {
+                            state.text = reader.attributes().value(QString(), role.attribute).toString();
+                            state.found = true;
+                        }
+                    }
+                }
+            }
+            break;
+        case QXmlStreamReader::Characters:
+            if (matched == itemDepth) {
+                for (int i = 0; i < roleCount; ++i) {
+                    if (states.at(i).captureDepth)
+                        states[i].text.append(reader.text());
+                }
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (matched == itemDepth && depth == itemDepth) {
+                QString key;
+                for (int i = 0; i < roleCount; ++i) {
+                    XmlStreamRoleState &state = states[i];
+                    if (state.captureDepth)
+                        state.found = true;
+                    data[i] << streamRoleValue(roles.at(i), state);
+                }
+                if (!chunked) {
+                    foreach (int i, currentJob->streamKeyRoles)
+                        key += states.at(i).text;
+                    keyRoleResults << key;
+                }
+                matched = depth - 1;
+
+                ++rows;
+                if (chunked && rows - sent == XMLLISTMODEL_STREAM_CHUNK_SIZE) {
+                    QQuickXmlQueryResult chunk;
+                    chunk.queryId = currentJob->queryId;
+                    chunk.offset = sent;
+                    chunk.size = rows;
+                    chunk.finished = false;
+                    chunk.data = data;
+                    for (int i = 0; i < roleCount; ++i)
+                        data[i] = QList<QVariant>();
+
+                    QMutexLocker ml(&m_mutex);
+                    if (m_cancelledJobs.remove(currentJob->queryId))
+                        return false;
+                    emit queryCompleted(chunk);
+                    sent = rows;
+                }
+            } else if (matched == itemDepth) {
+                const int relative = depth - itemDepth;
+                for (int i = 0; i < roleCount; ++i) {
+                    XmlStreamRoleState &state = states[i];
+                    if (state.captureDepth == depth) {
+                        state.captureDepth = 0;
+                        state.found = true;
+                    } else if (!state.found && state.matched == relative) {
+                        state.matched = relative - 1;
+                    }
+                }
+            } else if (matched == depth) {
+                matched = depth - 1;
+            }
+            --depth;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (reader.hasError()) {
+        // Like QXmlQuery, don't return anything from a document that isn't well formed.
+        sent = 0;
+        rows = 0;
+        keyRoleResults.clear();
+        for (int i = 0; i < roleCount; ++i)
+            data[i] = QList<QVariant>();
+    }
+
+    currentResult->offset = sent;
+    currentResult->size = rows;
+    currentResult->data = data;
+    compareKeyRoleResults(*currentJob, keyRoleResults, currentResult);
+    currentResult->keyRoleResultsCache = keyRoleResults;
+    return true;
+}
+
 class QQuickXmlListModelPrivate : public QAbstractItemModelPrivate
 {
     Q_DECLARE_PUBLIC(QQuickXmlListModel)
@@ -715,6 +1000,18 @@ void QQuickXmlListModelPrivate::clear_role(QQmlListProperty<QQuickXmlListModelRo
     with a combined value of all key roles that is not already present in
     the model.
 
+    \section2 Simple queries
+
+    If \l query is a plain path of element names such as "/rss/channel/item",
+    no \l namespaceDeclarations are set, and every XmlRole query is a path of
+    element names optionally ending in an attribute, followed by \c string()
+    or \c number() (for example "title/string()" or "enclosure/@url/string()"),
+    the document is read in a single pass instead of being evaluated with
+    XQuery. If there are no key roles, the model is then populated
+    progressively: rows are added in batches while the rest of the document
+    is still being read, and \l status only becomes \c XmlListModel.Ready
+    once all of it has been read.
+
     \sa {Qt Quick Demo - RSS News}
 */
 
@@ -1148,15 +1445,38 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
     int origCount = d->size;
     bool sizeChanged = result.size != d->size;
 
+    // Streamed rows must follow the ones already in the model
+    if (result.offset > 0 && result.offset != origCount)
+        return;
+
+    if (result.finished) {
+        d->keyRoleResultsCache = result.keyRoleResultsCache;
+        if (d->src.isEmpty() && d->xml.isEmpty())
+            d->status = Null;
+        else
+            d->status = Ready;
+        d->errorString.clear();
+        d->queryId = -1;
+    }
+
+    if (result.offset > 0) {
+        // Rows read after the ones already streamed to the model
+        for (int i = 0; i < result.data.count() && i < d->data.count(); ++i)
+            d->data[i] += result.data.at(i);
+        d->size = result.size;
+        if (d->size > origCount) {
+            beginInsertRows(QModelIndex(), origCount, d->size - 1);
+            endInsertRows();
+        }
+        if (sizeChanged)
+            emit countChanged();
+        if (result.finished)
+            emit statusChanged(d->status);
+        return;
+    }
+
     d->size = result.size;
     d->data = result.data;
-    d->keyRoleResultsCache = result.keyRoleResultsCache;
-    if (d->src.isEmpty() && d->xml.isEmpty())
-        d->status = Null;
-    else
-        d->status = Ready;
-    d->errorString.clear();
-    d->queryId = -1;
 
     bool hasKeys = false;
     for (int i=0; i<d->roleObjects.count(); i++) {
@@ -1195,7 +1515,8 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
     if (sizeChanged)
         emit countChanged();
 
-    emit statusChanged(d->status);
+    if (result.finished)
+        emit statusChanged(d->status);
 }
 
 QT_END_NAMESPACE
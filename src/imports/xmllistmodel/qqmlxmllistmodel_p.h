@@ -58,8 +58,12 @@ class QQuickXmlListModelRole;
 class QQuickXmlListModelPrivate;
 
 struct QQuickXmlQueryResult {
+    QQuickXmlQueryResult() : queryId(-1), size(0), offset(0), finished(true) {}
+
     int queryId;
     int size;
+    int offset;     // the row of the first entry in data; > 0 for rows appended to a streamed result
+    bool finished;  // false for the leading parts of a streamed result
     QList<QList<QVariant> > data;
     QList<QPair<int, int> > inserted;
     QList<QPair<int, int> > removed;
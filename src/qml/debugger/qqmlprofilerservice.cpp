@@ -107,6 +107,8 @@ QByteArray QQmlProfilerData::toByteArray() const
         case QQmlProfilerService::SceneGraphWindowsAnimations: ds << subtime_1; break;
         // WindowsRenderWindow: polish time
         case QQmlProfilerService::SceneGraphWindowsPolishFrame: ds << subtime_1; break;
+        // TextureUploadQueue: pendingUploads (which is an integer), uploadedBytes
+        case QQmlProfilerService::SceneGraphTextureUploadQueue: ds << (int)subtime_1 << subtime_2; break;
         default:break;
         }
     }
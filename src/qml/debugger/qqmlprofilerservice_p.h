@@ -163,6 +163,7 @@ public:
         SceneGraphWindowsRenderShow,
         SceneGraphWindowsAnimations,
         SceneGraphWindowsPolishFrame,
+        SceneGraphTextureUploadQueue,
 
         MaximumSceneGraphFrameType
     };
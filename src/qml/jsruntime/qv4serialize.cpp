@@ -51,6 +51,9 @@
 #include <private/qv4sequenceobject_p.h>
 #include <private/qv4objectproto_p.h>
 
+#include <cmath>
+#include <climits>
+
 QT_BEGIN_NAMESPACE
 
 using namespace QV4;
@@ -68,6 +71,13 @@ using namespace QV4;
 //    + Date
 //    + RegExp
 // <quint8 type><quint24 size><data>
+//
+// Arrays holding nothing but numbers are written as a single block of raw
+// doubles (WorkerNumberArray).  Every string written in full is also entered
+// into a per-message string table, and later occurrences of the same string
+// (typically the property names of an array of similar objects) are written
+// as a WorkerStringRef holding the table index.  The deserializer rebuilds
+// the table in the same order and reuses the string it created.
 
 enum Type {
     WorkerUndefined,
@@ -84,7 +94,9 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerNumberArray,
+    WorkerStringRef
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -119,7 +131,11 @@ static inline void push(QByteArray &data, void *ptr)
 
 static inline void reserve(QByteArray &data, int extra)
 {
-    data.reserve(data.size() + extra);
+    // QByteArray::reserve() allocates exactly what is asked for, so grow
+    // geometrically to keep serializing large values linear.
+    const int required = data.size() + extra;
+    if (required > data.capacity())
+        data.reserve(qMax(required, 2 * data.capacity()));
 }
 
 static inline quint32 popUint32(const char *&data)
@@ -143,11 +159,35 @@ static inline void *popPtr(const char *&data)
     return rv;
 }
 
+static inline ReturnedValue numberValue(double d)
+{
+    // Restore integers so that the result matches a per element WorkerInt32. Only values in
+    // range can be converted; the conversion is undefined for the others.
+    if (std::isnan(d) || d < INT_MIN || d > INT_MAX)
+        return QV4::Encode(d);
+    const int i = static_cast<int>(d);
+    if (i == d && (i != 0 || !std::signbit(d)))
+        return QV4::Encode(i);
+    return QV4::Encode(d);
+}
+
+// Returns true if \a array is a dense array holding only numbers
+static bool isNumberArray(ArrayObject *array, uint length)
+{
+    if (array->sparseArray || array->arrayAttributes || array->arrayDataLen < length)
+        return false;
+    for (uint ii = 0; ii < length; ++ii) {
+        if (!array->arrayData[ii].value.isNumber())
+            return false;
+    }
+    return true;
+}
+
 // XXX TODO: Check that worker script is exception safe in the case of 
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *engine)
+void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *engine, StringTable &strings)
 {
     QV4::ExecutionEngine *v4 = QV8Engine::getV4(engine);
     QV4::Scope scope(v4);
@@ -167,6 +207,15 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             push(data, valueheader(WorkerUndefined));
             return;
         }
+
+        StringTable::ConstIterator it = strings.constFind(qstr);
+        if (it != strings.constEnd()) {
+            push(data, valueheader(WorkerStringRef, *it));
+            return;
+        }
+        if (strings.count() < 0xFFFFFF)
+            strings.insert(qstr, strings.count());
+
         int utf16size = ALIGN(length * sizeof(uint16_t));
 
         reserve(data, utf16size + sizeof(quint32));
@@ -188,11 +237,25 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             push(data, valueheader(WorkerUndefined));
             return;
         }
+        if (length > 0 && isNumberArray(array.getPointer(), length)) {
+            reserve(data, sizeof(quint32) + length * sizeof(double));
+            push(data, valueheader(WorkerNumberArray, length));
+
+            int offset = data.size();
+            data.resize(data.size() + length * sizeof(double));
+            char *buffer = data.data() + offset;
+
+            for (uint32_t ii = 0; ii < length; ++ii) {
+                double d = array->arrayData[ii].value.toNumber();
+                memcpy(buffer + ii * sizeof(double), &d, sizeof(double));
+            }
+            return;
+        }
         reserve(data, sizeof(quint32) + length * sizeof(quint32));
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint32_t ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->getIndexed(ii)), engine);
+            serialize(data, (val = array->getIndexed(ii)), engine, strings);
     } else if (v->isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -255,10 +318,10 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine, strings); // sequence type
             ScopedValue val(scope);
             for (uint32_t ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->getIndexed(ii)), engine); // sequence elements
+                serialize(data, (val = o->getIndexed(ii)), engine, strings); // sequence elements
 
             return;
         }
@@ -277,7 +340,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
         QV4::ScopedString str(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->getIndexed(ii);
-            serialize(data, s, engine);
+            serialize(data, s, engine, strings);
 
             QV4::ExecutionContext *ctx = v4->currentContext();
             str = s;
@@ -285,7 +348,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
             if (scope.hasException())
                 ctx->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, engine, strings);
         }
         return;
     } else {
@@ -293,7 +356,7 @@ void Serialize::serialize(QByteArray &data, const QV4::ValueRef v, QV8Engine *en
     }
 }
 
-ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine, ArrayObject *strings)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -315,8 +378,14 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         quint32 size = headersize(header);
         QString qstr((QChar *)data, size);
         data += ALIGN(size * sizeof(uint16_t));
-        return QV4::Encode(v4->newString(qstr));
+        ScopedValue s(scope, v4->newString(qstr));
+        uint index = strings->arrayLength();
+        if (index < 0xFFFFFF)
+            strings->putIndexed(index, s);
+        return s.asReturnedValue();
     }
+    case WorkerStringRef:
+        return strings->getIndexed(headersize(header));
     case WorkerFunction:
         Q_ASSERT(!"Unreachable");
         break;
@@ -324,11 +393,29 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
     {
         quint32 size = headersize(header);
         Scoped<ArrayObject> a(scope, v4->newArrayObject());
+        a->arrayReserve(size);
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
-            a->putIndexed(ii, v);
+            v = deserialize(data, engine, strings);
+            a->arrayData[ii].value = v.asReturnedValue();
+            a->arrayDataLen = ii + 1;
+        }
+        a->setArrayLengthUnchecked(size);
+        return a.asReturnedValue();
+    }
+    case WorkerNumberArray:
+    {
+        quint32 size = headersize(header);
+        Scoped<ArrayObject> a(scope, v4->newArrayObject());
+        a->arrayReserve(size);
+        for (quint32 ii = 0; ii < size; ++ii) {
+            double d;
+            memcpy(&d, data + ii * sizeof(double), sizeof(double));
+            a->arrayData[ii].value = numberValue(d);
         }
+        a->arrayDataLen = size;
+        a->setArrayLengthUnchecked(size);
+        data += size * sizeof(double);
         return a.asReturnedValue();
     }
     case WorkerObject:
@@ -339,8 +426,8 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, engine, strings);
+            value = deserialize(data, engine, strings);
             n = name.asReturnedValue();
             o->put(n, value);
         }
@@ -366,6 +453,11 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
     {
         void *ptr = popPtr(data);
         QQmlListModelWorkerAgent *agent = (QQmlListModelWorkerAgent *)ptr;
+        if (!agent->setV8Engine(engine)) {
+            qWarning("ListModel: a model can only be passed to WorkerScripts running on one thread");
+            agent->release();
+            return QV4::Encode::undefined();
+        }
         QV4::ScopedValue rv(scope, QV4::QObjectWrapper::wrap(v4, agent));
         // ### Find a better solution then the ugly property
         QQmlListModelWorkerAgent::VariantRef ref(agent);
@@ -375,7 +467,6 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         rv->asObject()->defineReadonlyProperty(s, v);
 
         agent->release();
-        agent->setV8Engine(engine);
         return rv.asReturnedValue();
     }
     case WorkerSequence:
@@ -384,12 +475,12 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, engine, strings);
         int sequenceType = value->integerValue();
         Scoped<ArrayObject> array(scope, v4->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, engine, strings);
             array->arrayData[ii].value = value.asReturnedValue();
             array->arrayDataLen = ii + 1;
         }
@@ -405,14 +496,17 @@ ReturnedValue Serialize::deserialize(const char *&data, QV8Engine *engine)
 QByteArray Serialize::serialize(const QV4::ValueRef value, QV8Engine *engine)
 {
     QByteArray rv;
-    serialize(rv, value, engine);
+    StringTable strings;
+    serialize(rv, value, engine, strings);
     return rv;
 }
 
 ReturnedValue Serialize::deserialize(const QByteArray &data, QV8Engine *engine)
 {
     const char *stream = data.constData();
-    return deserialize(stream, engine);
+    Scope scope(QV8Engine::getV4(engine));
+    Scoped<ArrayObject> strings(scope, scope.engine->newArrayObject());
+    return deserialize(stream, engine, strings.getPointer());
 }
 
 QT_END_NAMESPACE
@@ -54,6 +54,7 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -69,8 +70,10 @@ public:
     static ReturnedValue deserialize(const QByteArray &, QV8Engine *);
 
 private:
-    static void serialize(QByteArray &, const ValueRef, QV8Engine *);
-    static ReturnedValue deserialize(const char *&, QV8Engine *);
+    typedef QHash<QString, quint32> StringTable;
+
+    static void serialize(QByteArray &, const ValueRef, QV8Engine *, StringTable &);
+    static ReturnedValue deserialize(const char *&, QV8Engine *, ArrayObject *);
 };
 
 }
@@ -213,6 +213,7 @@ void QQmlEnginePrivate::defineQtQuick2Module()
 
     // register the QtQuick2 types which are implemented in the QtQml module.
     registerQtQuick2Types("QtQuick",2,0);
+    qmlRegisterCustomType<QQmlListModel, 1>("QtQuick", 2, 3, "ListModel", new QQmlListModelParser);
     qmlRegisterUncreatableType<QQmlLocale>("QtQuick", 2, 0, "Locale", QQmlEngine::tr("Locale cannot be instantiated.  Use Qt.locale()"));
 }
 
@@ -556,7 +557,7 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 : propertyCapture(0), rootContext(0), isDebugging(false),
   outputWarningsToStdErr(true),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0), activeVME(0),
+  activeVME(0),
   activeObjectCreator(0),
   networkAccessManager(0), networkAccessManagerFactory(0), urlInterceptor(0),
   scarceResourcesRefCount(0), importDatabase(e), typeLoader(e), uniqueId(1),
@@ -821,12 +822,44 @@ void QQmlEnginePrivate::init()
     }
 }
 
+static int qml_workerscript_thread_count()
+{
+    static int count = -1;
+    if (count == -1) {
+        bool ok;
+        count = qgetenv("QML_WORKERSCRIPT_THREADS").toInt(&ok);
+        if (!ok)
+            count = 1;
+        else if (count <= 0)
+            count = QThread::idealThreadCount();
+        count = qMax(1, count);
+    }
+    return count;
+}
+
+/*
+    Returns the worker script engine a new WorkerScript should run on.  Each engine runs its
+    workers on a thread of its own, by default all workers share one but QML_WORKERSCRIPT_THREADS
+    allows spreading them over more threads.  A value of 0 uses one thread per core.
+*/
 QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    QQuickWorkerScriptEngine *engine = 0;
+    int engineWorkers = 0;
+    for (int i = 0; i < workerScriptEngines.count(); ++i) {
+        const int workers = workerScriptEngines.at(i)->workerScriptCount();
+        if (!engine || workers < engineWorkers) {
+            engine = workerScriptEngines.at(i);
+            engineWorkers = workers;
+        }
+    }
+
+    if (!engine || (engineWorkers > 0 && workerScriptEngines.count() < qml_workerscript_thread_count())) {
+        engine = new QQuickWorkerScriptEngine(q);
+        workerScriptEngines.append(engine);
+    }
+    return engine;
 }
 
 /*!
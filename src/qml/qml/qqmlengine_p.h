@@ -71,6 +71,7 @@
 #include <private/qrecyclepool_p.h>
 
 #include <QtCore/qlist.h>
+#include <QtCore/qvector.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qmutex.h>
@@ -160,7 +161,7 @@ public:
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
     QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
 
     QUrl baseUrl;
 
@@ -248,6 +248,27 @@ const ListLayout::Role *ListLayout::getExistingRole(const QV4::StringRef key)
     return r;
 }
 
+/*
+    Returns a shared copy of a string value if an equal string has been stored in the model
+    before.  Models populated from script often repeat the same short strings in every element,
+    sharing their data saves an allocation per element.  Only short strings are pooled and the
+    pool stops growing once it is full so unique values don't keep it growing with the model.
+    It is emptied when the model is cleared.
+*/
+QString ListLayout::internString(const QString &s)
+{
+    if (s.length() > MaxInternedStringLength)
+        return s;
+
+    QSet<QString>::const_iterator it = internedStrings.constFind(s);
+    if (it != internedStrings.constEnd())
+        return *it;
+
+    if (internedStrings.count() < MaxInternedStringCount)
+        internedStrings.insert(s);
+    return s;
+}
+
 ModelObject *ListModel::getOrCreateModelObject(QQmlListModel *model, int elementIndex)
 {
     ListElement *e = elements[elementIndex];
@@ -328,6 +349,100 @@ void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *>
     }
 }
 
+/*
+    Copies the elements with uids in elementUids, or all elements if it is null, into a new model
+    with its own copy of the layout.  The uids of all elements in order are written to order.
+    The snapshot shares no data with this model, so it can be synced to another thread's model
+    with syncChanges() while this one continues to be modified.
+*/
+ListModel *ListModel::createSnapshot(const QSet<int> *elementUids, QVector<int> *order)
+{
+    ListModel *snapshot = new ListModel(new ListLayout(m_layout), 0, m_uid);
+
+    order->reserve(elements.count());
+    for (int i=0 ; i < elements.count() ; ++i) {
+        ListElement *e = elements.at(i);
+        int uid = e->getUid();
+        order->append(uid);
+        if (elementUids == 0 || elementUids->contains(uid)) {
+            ListElement *copy = new ListElement(uid);
+            ListElement::sync(e, m_layout, copy, snapshot->m_layout, 0);
+            snapshot->elements.append(copy);
+        }
+    }
+
+    return snapshot;
+}
+
+void ListModel::destroySnapshot(ListModel *snapshot)
+{
+    ListLayout *layout = snapshot->m_layout;
+    snapshot->destroy();
+    delete snapshot;
+    delete layout;
+}
+
+/*
+    Applies a snapshot created by createSnapshot() to target.  Elements of the target not in
+    order are removed, the remaining ones are put in order and those in the snapshot updated.
+*/
+void ListModel::syncChanges(ListModel *snapshot, const QVector<int> &order, ListModel *target, QHash<int, ListModel *> *targetModelHash)
+{
+    if (targetModelHash)
+        targetModelHash->insert(target->m_uid, target);
+
+    ListLayout::sync(snapshot->m_layout, target->m_layout);
+
+    QHash<int, ListElement *> changed;
+    for (int i=0 ; i < snapshot->elements.count() ; ++i) {
+        ListElement *e = snapshot->elements.at(i);
+        changed.insert(e->getUid(), e);
+    }
+
+    bool reordered = order.count() != target->elements.count();
+    for (int i=0 ; !reordered && i < order.count() ; ++i)
+        reordered = order.at(i) != target->elements.at(i)->getUid();
+
+    if (reordered) {
+        QHash<int, ListElement *> existing;
+        for (int i=0 ; i < target->elements.count() ; ++i) {
+            ListElement *e = target->elements.at(i);
+            existing.insert(e->getUid(), e);
+        }
+
+        QPODVector<ListElement *, 4> elements;
+        elements.reserve(order.count());
+        for (int i=0 ; i < order.count() ; ++i) {
+            ListElement *e = existing.take(order.at(i));
+            if (e == 0)
+                e = new ListElement(order.at(i));
+            elements.append(e);
+        }
+
+        // Anything left over was removed.
+        QHash<int, ListElement *>::const_iterator it = existing.constBegin();
+        for (; it != existing.constEnd() ; ++it) {
+            it.value()->destroy(target->m_layout);
+            delete it.value();
+        }
+
+        elements.copyAndClear(target->elements);
+        target->updateCacheIndices();
+    }
+
+    if (changed.isEmpty())
+        return;
+
+    for (int i=0 ; i < target->elements.count() ; ++i) {
+        ListElement *e = target->elements.at(i);
+        if (ListElement *src = changed.value(e->getUid())) {
+            ListElement::sync(src, snapshot->m_layout, e, target->m_layout, targetModelHash);
+            if (e->m_objectCache)
+                e->m_objectCache->updateValues();
+        }
+    }
+}
+
 ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_layout(layout), m_modelCache(modelCache)
 {
     if (uid == -1)
@@ -358,6 +473,16 @@ void ListModel::insertElement(int index)
     updateCacheIndices();
 }
 
+void ListModel::insertElements(int index, int count)
+{
+    const bool shifted = index < elements.count();
+    elements.insertBlank(index, count);
+    for (int i=0 ; i < count ; ++i)
+        elements[index+i] = new ListElement;
+    if (shifted)
+        updateCacheIndices();
+}
+
 void ListModel::move(int from, int to, int n)
 {
     if (from > to) {
@@ -409,7 +534,7 @@ ListModel *ListModel::getListProperty(int elementIndex, const ListLayout::Role &
     return e->getListProperty(role);
 }
 
-void ListModel::set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles, QV8Engine *eng)
+void ListModel::set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles, QV8Engine *eng, const QSet<QString> *roleFilter)
 {
     ListElement *e = elements[elementIndex];
 
@@ -427,13 +552,16 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles
         if (!propertyName)
             break;
 
+        if (roleFilter && !roleFilter->contains(propertyName->toQString()))
+            continue;
+
         // Check if this key exists yet
         int roleIndex = -1;
 
         // Add the value now
         if ((s = propertyValue)) {
             const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
-            roleIndex = e->setStringProperty(r, s->toQString());
+            roleIndex = e->setStringProperty(r, m_layout->internString(s->toQString()));
         } else if (propertyValue->isNumber()) {
             const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
             roleIndex = e->setDoubleProperty(r, propertyValue->asDouble());
@@ -508,7 +636,7 @@ void ListModel::set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng)
         if (propertyValue->isString()) {
             const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
             if (r.type == ListLayout::Role::String)
-                e->setStringPropertyFast(r, propertyValue->stringValue()->toQString());
+                e->setStringPropertyFast(r, m_layout->internString(propertyValue->stringValue()->toQString()));
         } else if (propertyValue->isNumber()) {
             const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
             if (r.type == ListLayout::Role::Number) {
@@ -602,7 +730,10 @@ int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const Q
 
         const ListLayout::Role *r = m_layout->getRoleOrCreate(key, data);
         if (r) {
-            roleIndex = e->setVariantProperty(*r, data);
+            if (r->type == ListLayout::Role::String)
+                roleIndex = e->setStringProperty(*r, m_layout->internString(data.toString()));
+            else
+                roleIndex = e->setVariantProperty(*r, data);
 
             if (roleIndex != -1 && e->m_objectCache) {
                 QVector<int> roles;
@@ -1696,6 +1827,7 @@ void QQmlListModel::emitItemsChanged(int index, int count, const QVector<int> &r
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.changedChange(uid, index, count, roles);
+        m_agent->elementsChanged(this, index, count);
     }
 }
 
@@ -1728,6 +1860,7 @@ void QQmlListModel::emitItemsInserted(int index, int count)
     } else {
         int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
         m_agent->data.insertChange(uid, index, count);
+        m_agent->elementsChanged(this, index, count);
     }
 }
 
@@ -1883,6 +2016,7 @@ void QQmlListModel::clear()
         m_modelObjects.clear();
     } else {
         m_listModel->clear();
+        m_layout->clearInternedStrings();
     }
 
     emitItemsRemoved(0, cleared);
@@ -1909,20 +2043,25 @@ void QQmlListModel::remove(QQmlV4Function *args)
             return;
         }
 
-        if (m_dynamicRoles) {
-            for (int i=0 ; i < removeCount ; ++i)
-                delete m_modelObjects[index+i];
-            m_modelObjects.remove(index, removeCount);
-        } else {
-            m_listModel->remove(index, removeCount);
-        }
-
-        emitItemsRemoved(index, removeCount);
+        removeElements(index, removeCount);
     } else {
         qmlInfo(this) << tr("remove: incorrect number of arguments");
     }
 }
 
+void QQmlListModel::removeElements(int index, int removeCount)
+{
+    if (m_dynamicRoles) {
+        for (int i=0 ; i < removeCount ; ++i)
+            delete m_modelObjects[index+i];
+        m_modelObjects.remove(index, removeCount);
+    } else {
+        m_listModel->remove(index, removeCount);
+    }
+
+    emitItemsRemoved(index, removeCount);
+}
+
 /*!
     \qmlmethod ListModel::insert(int index, jsobject dict)
 
@@ -1954,19 +2093,7 @@ void QQmlListModel::insert(QQmlV4Function *args)
         QV4::ScopedObject argObject(scope, (*args)[1]);
         QV4::ScopedArrayObject objectArray(scope, (*args)[1]);
         if (objectArray) {
-            QV4::ScopedObject argObject(scope);
-
-            int objectArrayLength = objectArray->arrayLength();
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
-                    m_modelObjects.insert(index+i, DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->insert(index+i, argObject, args->engine());
-                }
-            }
-            emitItemsInserted(index, objectArrayLength);
+            insertArray(index, objectArray, args->engine());
         } else if (argObject) {
             if (m_dynamicRoles) {
                 m_modelObjects.insert(index, DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this));
@@ -1983,6 +2110,30 @@ void QQmlListModel::insert(QQmlV4Function *args)
     }
 }
 
+void QQmlListModel::insertArray(int index, QV4::ArrayObjectRef array, QV8Engine *eng)
+{
+    QV4::Scope scope(array->engine());
+    QV4::ScopedObject argObject(scope);
+
+    int arrayLength = array->arrayLength();
+    if (m_dynamicRoles) {
+        for (int i=0 ; i < arrayLength ; ++i) {
+            argObject = array->getIndexed(i);
+            m_modelObjects.insert(index+i, DynamicRoleModelNode::create(eng->variantMapFromJS(argObject), this));
+        }
+    } else {
+        // Create all the elements up front, inserting them one at a time shifts the following
+        // elements and updates their cached indices for every element inserted.
+        m_listModel->insertElements(index, arrayLength);
+        for (int i=0 ; i < arrayLength ; ++i) {
+            argObject = array->getIndexed(i);
+            m_listModel->set(index+i, argObject, eng);
+        }
+    }
+
+    emitItemsInserted(index, arrayLength);
+}
+
 /*!
     \qmlmethod ListModel::move(int from, int to, int n)
 
@@ -2056,22 +2207,7 @@ void QQmlListModel::append(QQmlV4Function *args)
         QV4::ScopedArrayObject objectArray(scope, (*args)[0]);
 
         if (objectArray) {
-            QV4::Scoped<QV4::Object> argObject(scope);
-
-            int objectArrayLength = objectArray->arrayLength();
-
-            int index = count();
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
-                    m_modelObjects.append(DynamicRoleModelNode::create(args->engine()->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->append(argObject, args->engine());
-                }
-            }
-
-            emitItemsInserted(index, objectArrayLength);
+            insertArray(count(), objectArray, args->engine());
         } else if (argObject) {
             int index;
 
@@ -2240,11 +2376,160 @@ void QQmlListModel::setProperty(int index, const QString& property, const QVaria
     }
 }
 
+/*!
+    \qmlmethod ListModel::setRows(int index, array dicts, array roles)
+    \since QtQuick 2.3
+
+    Changes consecutive items starting at \a index in the list model with the
+    values of each object in \a dicts.  As with set(), properties not appearing
+    in an object are left unchanged.  If the optional \a roles array is given
+    only the properties named in it are changed.
+
+    \code
+        fruitModel.setRows(2, [{"cost": 5.95}, {"cost": 2.45}, {"cost": 3.25}], ["cost"])
+    \endcode
+
+    All the changed items are reported to views in a single notification, which
+    makes updating many items much cheaper than calling set() or setProperty()
+    for each one.
+
+    The items to change must already exist in the list.
+
+    \sa set(), replaceRange()
+*/
+void QQmlListModel::setRows(QQmlV4Function *args)
+{
+    int argLength = args->length();
+    if (argLength != 2 && argLength != 3) {
+        qmlInfo(this) << tr("setRows: incorrect number of arguments");
+        return;
+    }
+
+    QV4::Scope scope(args->v4engine());
+    int index = QV4::ScopedValue(scope, (*args)[0])->toInt32();
+    QV4::ScopedArrayObject objectArray(scope, (*args)[1]);
+    if (!objectArray) {
+        qmlInfo(this) << tr("setRows: value is not an array");
+        return;
+    }
+
+    int objectArrayLength = objectArray->arrayLength();
+    if (index < 0 || index+objectArrayLength > count()) {
+        qmlInfo(this) << tr("setRows: indices [%1 - %2] out of range [0 - %3]").arg(index).arg(index+objectArrayLength).arg(count());
+        return;
+    }
+
+    QSet<QString> roleFilter;
+    if (argLength == 3) {
+        QV4::ScopedArrayObject roleArray(scope, (*args)[2]);
+        if (!roleArray) {
+            qmlInfo(this) << tr("setRows: roles is not an array");
+            return;
+        }
+        QV4::ScopedValue role(scope);
+        int roleArrayLength = roleArray->arrayLength();
+        for (int i=0 ; i < roleArrayLength ; ++i) {
+            role = roleArray->getIndexed(i);
+            roleFilter.insert(role->toQString());
+        }
+    }
+
+    QV4::ScopedObject argObject(scope);
+    QVector<int> roles;
+    QVector<int> changedRoles;
+    int first = objectArrayLength;
+    int last = -1;
+
+    for (int i=0 ; i < objectArrayLength ; ++i) {
+        argObject = objectArray->getIndexed(i);
+        if (!argObject)
+            continue;
+
+        roles.clear();
+        if (m_dynamicRoles) {
+            QVariantMap values = args->engine()->variantMapFromJS(argObject);
+            if (argLength == 3) {
+                QVariantMap::iterator it = values.begin();
+                while (it != values.end()) {
+                    if (roleFilter.contains(it.key()))
+                        ++it;
+                    else
+                        it = values.erase(it);
+                }
+            }
+            m_modelObjects[index+i]->updateValues(values, roles);
+        } else {
+            m_listModel->set(index+i, argObject, &roles, args->engine(), argLength == 3 ? &roleFilter : 0);
+        }
+
+        if (roles.isEmpty())
+            continue;
+
+        first = qMin(first, i);
+        last = i;
+        for (int j=0 ; j < roles.count() ; ++j) {
+            if (!changedRoles.contains(roles.at(j)))
+                changedRoles.append(roles.at(j));
+        }
+    }
+
+    if (last != -1)
+        emitItemsChanged(index+first, last-first+1, changedRoles);
+}
+
+/*!
+    \qmlmethod ListModel::replaceRange(int index, int count, array dicts)
+    \since QtQuick 2.3
+
+    Replaces \a count items starting at \a index in the list model with new
+    items holding the values of each object in \a dicts.  The number of new
+    items does not need to equal \a count.
+
+    \code
+        fruitModel.replaceRange(0, fruitModel.count, [{"cost": 5.95, "name":"Pizza"}, {"cost": 2.45, "name":"Apple"}])
+    \endcode
+
+    Views are told of the removed and the inserted items with one notification
+    each.
+
+    \sa remove(), insert(), setRows()
+*/
+void QQmlListModel::replaceRange(QQmlV4Function *args)
+{
+    if (args->length() != 3) {
+        qmlInfo(this) << tr("replaceRange: incorrect number of arguments");
+        return;
+    }
+
+    QV4::Scope scope(args->v4engine());
+    int index = QV4::ScopedValue(scope, (*args)[0])->toInt32();
+    int removeCount = QV4::ScopedValue(scope, (*args)[1])->toInt32();
+    QV4::ScopedArrayObject objectArray(scope, (*args)[2]);
+    if (!objectArray) {
+        qmlInfo(this) << tr("replaceRange: value is not an array");
+        return;
+    }
+
+    if (index < 0 || removeCount < 0 || index+removeCount > count()) {
+        qmlInfo(this) << tr("replaceRange: indices [%1 - %2] out of range [0 - %3]").arg(index).arg(index+removeCount).arg(count());
+        return;
+    }
+
+    if (removeCount > 0)
+        removeElements(index, removeCount);
+    insertArray(index, objectArray, args->engine());
+}
+
 /*!
     \qmlmethod ListModel::sync()
 
     Writes any unsaved changes to the list model after it has been modified
     from a worker script.
+
+    Unless \l dynamicRoles is enabled, only the items changed since the last
+    sync are copied and the worker script does not wait for the list model to
+    be updated.  The changes are applied when the main thread next processes
+    events.
 */
 void QQmlListModel::sync()
 {
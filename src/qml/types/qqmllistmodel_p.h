@@ -87,6 +87,8 @@ public:
     Q_INVOKABLE QQmlV4Handle get(int index) const;
     Q_INVOKABLE void set(int index, const QQmlV4Handle &);
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
+    Q_REVISION(1) Q_INVOKABLE void setRows(QQmlV4Function *args);
+    Q_REVISION(1) Q_INVOKABLE void replaceRange(QQmlV4Function *args);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
 
@@ -116,6 +118,9 @@ private:
 
     inline bool canMove(int from, int to, int n) const { return !(from+n > count() || to+n > count() || from < 0 || to < 0 || n < 0); }
 
+    void insertArray(int index, QV4::ArrayObjectRef array, QV8Engine *eng);
+    void removeElements(int index, int removeCount);
+
     QQmlListModelWorkerAgent *m_agent;
     mutable QV8Engine *m_engine;
     bool m_mainThread;
@@ -58,6 +58,8 @@
 #include <private/qqmlopenmetaobject_p.h>
 #include <qqml.h>
 
+#include <QtCore/qset.h>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -218,15 +220,21 @@ public:
 
     int roleCount() const { return roles.count(); }
 
+    QString internString(const QString &s);
+    void clearInternedStrings() { internedStrings.clear(); }
+
     static void sync(ListLayout *src, ListLayout *target);
 
 private:
     const Role &createRole(const QString &key, Role::DataType type);
 
+    enum { MaxInternedStringLength = 64, MaxInternedStringCount = 4096 };
+
     int currentBlock;
     int currentBlockOffset;
     QVector<Role *> roles;
     QStringHash<Role *> roleHash;
+    QSet<QString> internedStrings;
 };
 
 /*!
@@ -333,7 +341,7 @@ public:
         return elements.count();
     }
 
-    void set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles, QV8Engine *eng);
+    void set(int elementIndex, QV4::ObjectRef object, QVector<int> *roles, QV8Engine *eng, const QSet<QString> *roleFilter = 0);
     void set(int elementIndex, QV4::ObjectRef object, QV8Engine *eng);
 
     int append(QV4::ObjectRef object, QV8Engine *eng);
@@ -344,13 +352,19 @@ public:
 
     int appendElement();
     void insertElement(int index);
+    void insertElements(int index, int count);
 
     void move(int from, int to, int n);
 
     int getUid() const { return m_uid; }
+    int getElementUid(int elementIndex) const { return elements.at(elementIndex)->getUid(); }
 
     static void sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *srcModelHash);
 
+    ListModel *createSnapshot(const QSet<int> *elementUids, QVector<int> *order);
+    static void destroySnapshot(ListModel *snapshot);
+    static void syncChanges(ListModel *snapshot, const QVector<int> &order, ListModel *target, QHash<int, ListModel *> *targetModelHash);
+
     ModelObject *getOrCreateModelObject(QQmlListModel *model, int elementIndex);
 
 private:
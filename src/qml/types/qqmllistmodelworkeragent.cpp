@@ -87,6 +87,12 @@ void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count
     changes << c;
 }
 
+QQmlListModelWorkerAgent::Sync::~Sync()
+{
+    if (snapshot)
+        ListModel::destroySnapshot(snapshot);
+}
+
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
 : m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
 {
@@ -99,9 +105,18 @@ QQmlListModelWorkerAgent::~QQmlListModelWorkerAgent()
     mutex.unlock();
 }
 
-void QQmlListModelWorkerAgent::setV8Engine(QV8Engine *eng)
+/*
+    Binds the worker copy of the model to the engine of the worker receiving it.  The copy is
+    not thread-safe, so it stays bound to the first worker script engine; returns false for
+    any other engine.
+*/
+bool QQmlListModelWorkerAgent::setV8Engine(QV8Engine *eng)
 {
+    QMutexLocker locker(&mutex);
+    if (m_copy->m_engine && m_copy->m_engine != eng)
+        return false;
     m_copy->m_engine = eng;
+    return true;
 }
 
 void QQmlListModelWorkerAgent::addref()
@@ -162,17 +177,53 @@ void QQmlListModelWorkerAgent::setProperty(int index, const QString& property, c
     m_copy->setProperty(index, property, value);
 }
 
+void QQmlListModelWorkerAgent::setRows(QQmlV4Function *args)
+{
+    m_copy->setRows(args);
+}
+
+void QQmlListModelWorkerAgent::replaceRange(QQmlV4Function *args)
+{
+    m_copy->replaceRange(args);
+}
+
 void QQmlListModelWorkerAgent::move(int from, int to, int count)
 {
     m_copy->move(from, to, count);
 }
 
+void QQmlListModelWorkerAgent::elementsChanged(QQmlListModel *model, int index, int count)
+{
+    if (data.syncAll)
+        return;
+
+    // Elements of nested lists aren't tracked, any change to one copies the whole model.
+    if (model != m_copy || model->m_dynamicRoles) {
+        data.syncAll = true;
+        return;
+    }
+
+    for (int i=0 ; i < count ; ++i)
+        data.changedElements.insert(m_copy->m_listModel->getElementUid(index + i));
+}
+
 void QQmlListModelWorkerAgent::sync()
 {
     Sync *s = new Sync;
     s->data = data;
     s->list = m_copy;
     data.changes.clear();
+    data.changedElements.clear();
+    data.syncAll = false;
+
+    if (!m_copy->m_dynamicRoles) {
+        // Hand the changed elements over in a snapshot so the worker can carry on without
+        // waiting for the model to be updated.
+        s->snapshot = m_copy->m_listModel->createSnapshot(
+                    s->data.syncAll ? 0 : &s->data.changedElements, &s->order);
+        QCoreApplication::postEvent(this, s);
+        return;
+    }
 
     mutex.lock();
     QCoreApplication::postEvent(this, s);
@@ -189,16 +240,17 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
             Sync *s = static_cast<Sync *>(e);
             const QList<Change> &changes = s->data.changes;
 
-            cc = m_orig->count() != s->list->count();
-
             QHash<int, QQmlListModel *> targetModelDynamicHash;
             QHash<int, ListModel *> targetModelStaticHash;
 
-            Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
-            if (m_orig->m_dynamicRoles)
+            Q_ASSERT(m_orig->m_dynamicRoles == (s->snapshot == 0));
+            if (s->snapshot) {
+                cc = m_orig->count() != s->order.count();
+                ListModel::syncChanges(s->snapshot, s->order, m_orig->m_listModel, &targetModelStaticHash);
+            } else {
+                cc = m_orig->count() != s->list->count();
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
-            else
-                ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
+            }
 
             for (int ii = 0; ii < changes.count(); ++ii) {
                 const Change &change = changes.at(ii);
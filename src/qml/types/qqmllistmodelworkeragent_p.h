@@ -57,6 +57,7 @@
 
 #include <QMutex>
 #include <QWaitCondition>
+#include <QSet>
 
 #include <private/qv8engine_p.h>
 
@@ -64,6 +65,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QQmlListModel;
+class ListModel;
 
 class QQmlListModelWorkerAgent : public QObject
 {
@@ -73,7 +75,7 @@ class QQmlListModelWorkerAgent : public QObject
 public:
     QQmlListModelWorkerAgent(QQmlListModel *);
     ~QQmlListModelWorkerAgent();
-    void setV8Engine(QV8Engine *eng);
+    bool setV8Engine(QV8Engine *eng);
 
     void addref();
     void release();
@@ -87,6 +89,8 @@ public:
     Q_INVOKABLE QQmlV4Handle get(int index) const;
     Q_INVOKABLE void set(int index, const QQmlV4Handle &);
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
+    Q_INVOKABLE void setRows(QQmlV4Function *args);
+    Q_INVOKABLE void replaceRange(QQmlV4Function *args);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
 
@@ -126,7 +130,11 @@ private:
 
     struct Data
     {
+        Data() : syncAll(false) {}
+
         QList<Change> changes;
+        QSet<int> changedElements;  // uids of inserted or changed elements
+        bool syncAll;
 
         void clearChange(int uid);
         void insertChange(int uid, int index, int count);
@@ -137,11 +145,16 @@ private:
     Data data;
 
     struct Sync : public QEvent {
-        Sync() : QEvent(QEvent::User) {}
+        Sync() : QEvent(QEvent::User), list(0), snapshot(0) {}
+        ~Sync();
         Data data;
         QQmlListModel *list;
+        ListModel *snapshot;
+        QVector<int> order;
     };
 
+    void elementsChanged(QQmlListModel *model, int index, int count);
+
     QAtomicInt m_ref;
     QQmlListModel *m_orig;
     QQmlListModel *m_copy;
@@ -538,6 +538,12 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
     }
 }
 
+int QQuickWorkerScriptEngine::workerScriptCount() const
+{
+    QMutexLocker locker(&d->m_lock);
+    return d->workers.count();
+}
+
 void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
 {
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
@@ -611,6 +617,18 @@ void QQuickWorkerScriptEngine::run()
 
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
+    \section3 Worker Threads
+
+    By default all the WorkerScript objects of an engine share a single thread,
+    so a busy worker delays the messages of every other worker.  Setting the
+    \c QML_WORKERSCRIPT_THREADS environment variable to a number greater than
+    one lets the engine spread workers over up to that many threads, each with
+    its own JavaScript engine, and \c 0 uses one thread per processor core.
+    A worker always stays on the thread it started on.  A ListModel can only
+    be used by the workers of one thread: the workers of the thread it is
+    first passed to receive it, while the others receive \c undefined and a
+    warning is printed.
+
     \sa {declarative/threading/workerscript}{WorkerScript example},
         {declarative/threading/threadedlistmodel}{Threaded ListModel example}
 */
@@ -77,6 +77,8 @@ public:
     void executeUrl(int, const QUrl &);
     void sendMessage(int, const QByteArray &);
 
+    int workerScriptCount() const;
+
 protected:
     virtual void run();
 
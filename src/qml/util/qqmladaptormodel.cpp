@@ -103,6 +103,7 @@ public:
     int metaCall(QMetaObject::Call call, int id, void **arguments);
 
     virtual QVariant value(int role) const = 0;
+    virtual QVariant propertyValue(int propertyIndex) const;
     virtual void setValue(int role, const QVariant &value) = 0;
 
     void setValue(const QString &role, const QVariant &value);
@@ -258,6 +259,11 @@ public:
     bool hasModelData;
 };
 
+QVariant QQmlDMCachedModelData::propertyValue(int propertyIndex) const
+{
+    return value(type->propertyRoles.at(propertyIndex));
+}
+
 QQmlDMCachedModelData::QQmlDMCachedModelData(
         QQmlDelegateModelItemMetaType *metaType, VDMModelDelegateDataType *dataType, int index)
     : QQmlDelegateModelItem(metaType, index)
@@ -285,7 +291,7 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
                     type->hasModelData ? 0 : propertyIndex);
             }
         } else  if (*type->model) {
-            *static_cast<QVariant *>(arguments[0]) = value(type->propertyRoles.at(propertyIndex));
+            *static_cast<QVariant *>(arguments[0]) = propertyValue(propertyIndex);
         }
         return -1;
     } else if (call == QMetaObject::WriteProperty && id >= type->propertyOffset) {
@@ -353,8 +359,7 @@ QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, ui
                     modelData->cachedData.at(modelData->type->hasModelData ? 0 : propertyId));
         }
     } else if (*modelData->type->model) {
-        return ctx->engine->v8Engine->fromVariant(
-                modelData->value(modelData->type->propertyRoles.at(propertyId)));
+        return ctx->engine->v8Engine->fromVariant(modelData->propertyValue(propertyId));
     }
     return QV4::Encode::undefined();
 }
@@ -388,6 +393,8 @@ QV4::ReturnedValue QQmlDMCachedModelData::set_property(QV4::CallContext *ctx, ui
 // QAbstractItemModel
 //-----------------------------------------------------------------
 
+class VDMAbstractItemModelDataType;
+
 class QQmlDMAbstractItemModelData : public QQmlDMCachedModelData
 {
     Q_OBJECT
@@ -398,6 +405,7 @@ public:
             VDMModelDelegateDataType *dataType,
             int index)
         : QQmlDMCachedModelData(metaType, dataType, index)
+        , rowDataIndex(-1)
     {
     }
 
@@ -422,6 +430,8 @@ public:
                 type->model->aim()->index(index, 0, type->model->rootIndex), value, role);
     }
 
+    QVariant propertyValue(int propertyIndex) const;
+
     QV4::ReturnedValue get()
     {
         if (type->prototype.isUndefined()) {
@@ -435,6 +445,12 @@ public:
         ++scriptRef;
         return o.asReturnedValue();
     }
+
+    // The values of the row rowDataIndex fetched through the QQmlAdaptorModelMultiDataInterface
+    // of the model, in the order of the data type's fetchRoles.  Holds only the roles that had
+    // been read by a delegate when the row was fetched.
+    mutable QVector<QVariant> rowData;
+    mutable int rowDataIndex;
 };
 
 class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
@@ -442,7 +458,79 @@ class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
 public:
     VDMAbstractItemModelDataType(QQmlAdaptorModel *model)
         : VDMModelDelegateDataType(model)
+        , multiData(0)
+    {
+    }
+
+    bool notify(
+            const QQmlAdaptorModel &model,
+            const QList<QQmlDelegateModelItem *> &items,
+            int index,
+            int count,
+            const QVector<int> &roles) const
+    {
+        if (multiData)
+            refreshRowData(model, items, index, count, roles);
+        return VDMModelDelegateDataType::notify(model, items, index, count, roles);
+    }
+
+    // Refetches the rows of all items in the changed range that have fetched their
+    // values before with a single call, so they don't each fetch their row again
+    // when their bindings are re-evaluated.
+    void refreshRowData(
+            const QQmlAdaptorModel &model,
+            const QList<QQmlDelegateModelItem *> &items,
+            int index,
+            int count,
+            const QVector<int> &roles) const
+    {
+        if (!roles.isEmpty()) {
+            bool fetched = false;
+            for (int i = 0; i < roles.count() && !fetched; ++i)
+                fetched = fetchRoles.contains(roles.at(i));
+            if (!fetched)
+                return;
+        }
+
+        int first = index + count;
+        int last = index - 1;
+        for (int i = 0, c = items.count(); i < c; ++i) {
+            const QQmlDMAbstractItemModelData *item = cachedRowItem(items.at(i), index, count);
+            if (item) {
+                first = qMin(first, item->rowDataIndex);
+                last = qMax(last, item->rowDataIndex);
+            }
+        }
+        if (first > last)
+            return;
+
+        const int roleCount = fetchRoles.count();
+        QVector<QVariant> values((last - first + 1) * roleCount);
+        multiData->multiData(model.rootIndex, first, last - first + 1, fetchRoles, values.data());
+
+        for (int i = 0, c = items.count(); i < c; ++i) {
+            const QQmlDMAbstractItemModelData *item = cachedRowItem(items.at(i), index, count);
+            if (item) {
+                const QVariant *rowValues = values.constData() + (item->rowDataIndex - first) * roleCount;
+                item->rowData.resize(roleCount);
+                for (int j = 0; j < roleCount; ++j)
+                    item->rowData[j] = rowValues[j];
+            }
+        }
+    }
+
+    const QQmlDMAbstractItemModelData *cachedRowItem(QQmlDelegateModelItem *item, int index, int count) const
     {
+        const QQmlDMAbstractItemModelData *data = qobject_cast<QQmlDMAbstractItemModelData *>(item);
+        return data
+                && data->type == this
+                && data->rowDataIndex != -1
+                && !data->rowData.isEmpty()
+                && data->rowDataIndex == data->index
+                && data->rowDataIndex >= index
+                && data->rowDataIndex < index + count
+                ? data
+                : 0;
     }
 
     int count(const QQmlAdaptorModel &model) const
@@ -547,12 +635,65 @@ public:
             addProperty(&builder, 1, propertyName, propertyType);
         }
 
+        multiData = qobject_cast<QQmlAdaptorModelMultiDataInterface *>(model.aim());
+        if (multiData)
+            fetchPositions.fill(-1, propertyRoles.count());
+
         metaObject = builder.toMetaObject();
         *static_cast<QMetaObject *>(this) = *metaObject;
         propertyCache = new QQmlPropertyCache(engine, metaObject);
     }
+
+    // Returns the position of the role of a property in fetchRoles.  Roles are only fetched
+    // once a delegate has read them, so a role is added the first time it is asked for.
+    int fetchPosition(int propertyIndex)
+    {
+        int position = fetchPositions.at(propertyIndex);
+        if (position == -1) {
+            const int role = propertyRoles.at(propertyIndex);
+            position = fetchRoles.count();
+            fetchRoles.append(role);
+            for (int i = 0; i < propertyRoles.count(); ++i) {
+                if (propertyRoles.at(i) == role)
+                    fetchPositions[i] = position;
+            }
+        }
+        return position;
+    }
+
+    QQmlAdaptorModelMultiDataInterface *multiData;
+    QVector<int> fetchRoles;
+    QVector<int> fetchPositions;
 };
 
+QVariant QQmlDMAbstractItemModelData::propertyValue(int propertyIndex) const
+{
+    VDMAbstractItemModelDataType *dataType = static_cast<VDMAbstractItemModelDataType *>(type);
+    if (!dataType->multiData)
+        return QQmlDMCachedModelData::propertyValue(propertyIndex);
+
+    if (rowDataIndex != index) {
+        rowData.clear();
+        rowDataIndex = index;
+    }
+
+    const int position = dataType->fetchPosition(propertyIndex);
+    if (position >= rowData.count()) {
+        // Fetch every role read by delegates so far that this row doesn't have yet.
+        const int fetched = rowData.count();
+        const int count = dataType->fetchRoles.count();
+        QVector<int> roles;
+        roles.reserve(count - fetched);
+        for (int i = fetched; i < count; ++i)
+            roles.append(dataType->fetchRoles.at(i));
+
+        rowData.resize(count);
+        dataType->multiData->multiData(
+                dataType->model->rootIndex, index, 1, roles, rowData.data() + fetched);
+    }
+    return rowData.at(position);
+}
+
 //-----------------------------------------------------------------
 // QQmlListAccessor
 //-----------------------------------------------------------------
@@ -149,6 +149,27 @@ public:
 
 Q_DECLARE_INTERFACE(QQmlAdaptorModelProxyInterface, QQmlAdaptorModelProxyInterface_iid)
 
+// Implemented by a QAbstractItemModel to let delegates fetch all the roles of a range of rows
+// with a single call instead of calling index() and data() for every role that is read.
+class QQmlAdaptorModelMultiDataInterface
+{
+public:
+    virtual ~QQmlAdaptorModelMultiDataInterface() {}
+
+    // Writes the values of \a roles for the \a count rows of \a parent starting at \a row
+    // to \a data, one row after the other.
+    virtual void multiData(
+            const QModelIndex &parent,
+            int row,
+            int count,
+            const QVector<int> &roles,
+            QVariant *data) const = 0;
+};
+
+#define QQmlAdaptorModelMultiDataInterface_iid "org.qt-project.Qt.QQmlAdaptorModelMultiDataInterface"
+
+Q_DECLARE_INTERFACE(QQmlAdaptorModelMultiDataInterface, QQmlAdaptorModelMultiDataInterface_iid)
+
 QT_END_NAMESPACE
 
 #endif
@@ -98,8 +98,15 @@ QT_BEGIN_NAMESPACE
     for a specific index, each time a lookup is done the range and its indexes are cached and the
     next lookup is done relative to this.   This works out to near constant time in most relevant
     use cases because successive index lookups are most frequently adjacent.  The total number of
-    ranges is often quite small, which helps as well. If there is a need for faster random access
-    then a skip list like index may be an appropriate addition.
+    ranges is often quite small, which helps as well.
+
+    For large and fragmented compositors where lookups jump about, a sparse index of every
+    IndexStride'th range and its group indexes is kept as well.  A lookup far from the cached
+    iterator does a binary search of the index for the nearest preceding range and iterates from
+    there, which bounds the cost of a random lookup by the log of the number of ranges plus the
+    stride.  The index is discarded by any change to the ranges and only rebuilt once the distance
+    iterated by lookups since the change is comparable to the size of the compositor, so that
+    interleaved changes and nearby lookups don't pay for rebuilding it.
 
     \sa VisualDataModel
 */
@@ -293,6 +300,8 @@ QQmlListCompositor::QQmlListCompositor()
     , m_defaultFlags(PrependFlag | DefaultFlag)
     , m_removeFlags(AppendFlag | PrependFlag | GroupMask)
     , m_moveId(0)
+    , m_unindexedDistance(0)
+    , m_indexValid(false)
 {
 }
 
@@ -344,6 +353,7 @@ void QQmlListCompositor::setGroupCount(int count)
     m_groupCount = count;
     m_end = iterator(&m_ranges, 0, Default, m_groupCount);
     m_cacheIt = m_end;
+    invalidateIndex();
 }
 
 /*!
@@ -365,7 +375,10 @@ QQmlListCompositor::iterator QQmlListCompositor::find(Group group, int index)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index < count(group));
-    if (m_cacheIt == m_end) {
+    if (useIndex(group, m_cacheIt == m_end ? index : qAbs(index - m_cacheIt.index[group]))) {
+        m_cacheIt = indexedPosition(group, index);
+        m_cacheIt += index - m_cacheIt.index[group];
+    } else if (m_cacheIt == m_end) {
         m_cacheIt = iterator(m_ranges.next, 0, group, m_groupCount);
         m_cacheIt += index;
     } else {
@@ -407,7 +420,10 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index <= count(group));
     insert_iterator it;
-    if (m_cacheIt == m_end) {
+    if (useIndex(group, m_cacheIt == m_end ? index : qAbs(index - m_cacheIt.index[group]))) {
+        it = indexedPosition(group, index);
+        it += index - it.index[group];
+    } else if (m_cacheIt == m_end) {
         it = iterator(m_ranges.next, 0, group, m_groupCount);
         it += index;
     } else {
@@ -420,6 +436,77 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
     return it;
 }
 
+/*!
+    \internal
+
+    Returns whether a lookup \a distance items away from the cached iterator in a \a group
+    should use the range index.  The index is rebuilt if the total distance iterated since it
+    was invalidated exceeds a quarter of the size of the group.
+*/
+
+bool QQmlListCompositor::useIndex(Group group, int distance)
+{
+    if (distance <= IndexStride)
+        return false;
+    if (m_indexValid)
+        return true;
+    m_unindexedDistance += distance;
+    if (m_unindexedDistance <= m_end.index[group] / 4)
+        return false;
+    buildIndex();
+    return true;
+}
+
+/*!
+    \internal
+
+    Records the group indexes of every IndexStride'th range.
+*/
+
+void QQmlListCompositor::buildIndex()
+{
+    m_index.resize(0);
+    IndexEntry entry;
+    iterator it(m_ranges.next, 0, Default, m_groupCount);
+    for (int i = 0; *it != &m_ranges; *it = it->next, ++i) {
+        if (i % IndexStride == 0) {
+            entry.range = *it;
+            for (int j = 0; j < m_groupCount; ++j)
+                entry.index[j] = it.index[j];
+            m_index.append(entry);
+        }
+        it.incrementIndexes(it->count);
+    }
+    m_indexValid = true;
+}
+
+/*!
+    \internal
+
+    Returns an iterator for the start of the last indexed range which precedes the item at
+    \a index in a \a group.
+*/
+
+QQmlListCompositor::iterator QQmlListCompositor::indexedPosition(Group group, int index) const
+{
+    Q_ASSERT(m_indexValid && !m_index.isEmpty());
+    // Start from the last entry before index, iterating from an entry at index could step back.
+    int low = 0;
+    int high = m_index.count() - 1;
+    while (low < high) {
+        const int mid = (low + high + 1) / 2;
+        if (m_index.at(mid).index[group] < index)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    const IndexEntry &entry = m_index.at(low);
+    iterator it(entry.range, 0, group, m_groupCount);
+    for (int i = 0; i < m_groupCount; ++i)
+        it.index[i] = entry.index[i];
+    return it;
+}
+
 /*!
     Appends a range of \a count indexes starting at \a index from a \a list into a compositor
     with the given \a flags.
@@ -501,6 +588,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
 
     m_end.incrementIndexes(count, flags);
     m_cacheIt = before;
+    invalidateIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
     return before;
 }
@@ -612,6 +700,7 @@ void QQmlListCompositor::setFlags(
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
+    invalidateIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -727,6 +816,7 @@ void QQmlListCompositor::clearFlags(
         *from = erase(*from)->previous;
     }
     m_cacheIt = from;
+    invalidateIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -932,6 +1022,7 @@ void QQmlListCompositor::move(
     }
 
     m_cacheIt = toIt;
+    invalidateIndex();
 
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
@@ -946,6 +1037,7 @@ void QQmlListCompositor::clear()
     for (Range *range = m_ranges.next; range != &m_ranges; range = erase(range)) {}
     m_end = iterator(m_ranges.next, 0, Default, m_groupCount);
     m_cacheIt = m_end;
+    invalidateIndex();
 }
 
 void QQmlListCompositor::listItemsInserted(
@@ -1041,6 +1133,7 @@ void QQmlListCompositor::listItemsInserted(
         it.incrementIndexes(it->count);
     }
     m_cacheIt = m_end;
+    invalidateIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
@@ -1231,6 +1324,7 @@ void QQmlListCompositor::listItemsRemoved(
         }
     }
     m_cacheIt = m_end;
+    invalidateIndex();
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
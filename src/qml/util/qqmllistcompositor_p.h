@@ -275,9 +275,26 @@ private:
     int m_removeFlags;
     int m_moveId;
 
+    enum { IndexStride = 32 };
+
+    struct IndexEntry
+    {
+        Range *range;
+        int index[MaximumGroupCount];
+    };
+
+    QVector<IndexEntry> m_index;
+    int m_unindexedDistance;
+    bool m_indexValid;
+
     inline Range *insert(Range *before, void *list, int index, int count, uint flags);
     inline Range *erase(Range *range);
 
+    inline void invalidateIndex() { m_indexValid = false; m_unindexedDistance = 0; }
+    bool useIndex(Group group, int distance);
+    void buildIndex();
+    iterator indexedPosition(Group group, int index) const;
+
     struct MovedFlags
     {
         MovedFlags() {}
@@ -221,7 +221,7 @@ QQuickFlickablePrivate::QQuickFlickablePrivate()
     , vData(this, &QQuickFlickablePrivate::setViewportY)
     , hMoved(false), vMoved(false)
     , stealMouse(false), pressed(false), interactive(true), calcVelocity(false)
-    , pixelAligned(false), replayingPressEvent(false)
+    , pixelAligned(false), replayingPressEvent(false), cullsContent(false), cullingDirty(true)
     , lastPosTime(-1)
     , lastPressTime(0)
     , deceleration(QML_FLICK_DEFAULTDECELERATION)
@@ -230,7 +230,7 @@ QQuickFlickablePrivate::QQuickFlickablePrivate()
     , flickBoost(1.0), fixupMode(Normal), vTime(0), visibleArea(0)
     , flickableDirection(QQuickFlickable::AutoFlickDirection)
     , boundsBehavior(QQuickFlickable::DragAndOvershootBounds)
-    , rebound(0)
+    , rebound(0), cullPass(0)
 {
 }
 
@@ -298,6 +298,9 @@ void QQuickFlickablePrivate::itemGeometryChanged(QQuickItem *item, const QRectF
             emit q->contentXChanged();
         if (orient & Qt::Vertical)
             emit q->contentYChanged();
+    } else if (cullItems.contains(item)) {
+        // A culled item, or the item containing it, may have moved into view.
+        cullingDirty = true;
     }
 }
 
@@ -683,6 +686,10 @@ QQuickFlickable::QQuickFlickable(QQuickFlickablePrivate &dd, QQuickItem *parent)
 
 QQuickFlickable::~QQuickFlickable()
 {
+    Q_D(QQuickFlickable);
+    d->setCullingWindow(0);
+    // The window may be gone already, the watched items still know the flickable.
+    d->uncullContent();
 }
 
 /*!
@@ -887,6 +894,41 @@ void QQuickFlickable::setFlickableDirection(FlickableDirection direction)
     }
 }
 
+/*!
+    \qmlproperty bool QtQuick::Flickable::cullsContent
+    \since QtQuick 2.3
+
+    This property holds whether items of the content which cannot be seen are hidden from the
+    renderer.
+
+    When enabled, the flickable hides the items of its content which lie entirely outside of
+    the window, and outside of the flickable if \l {Item::}{clip} is enabled, whenever the
+    content is moved or resized. Hidden items keep their visible property, but are not drawn
+    and their graphics are not updated until they come back into view.
+
+    Only the children of the content item and their children, up to a depth of three, are
+    culled. Items are culled by their bounding rectangle, so an item which draws outside of it
+    without being clipped may disappear while part of it can still be seen.
+
+    The default is \c false.
+*/
+bool QQuickFlickable::cullsContent() const
+{
+    Q_D(const QQuickFlickable);
+    return d->cullsContent;
+}
+
+void QQuickFlickable::setCullsContent(bool cull)
+{
+    Q_D(QQuickFlickable);
+    if (cull == d->cullsContent)
+        return;
+
+    d->cullsContent = cull;
+    d->setCullingWindow(cull ? window() : 0);
+    emit cullsContentChanged();
+}
+
 /*!
     \qmlproperty bool QtQuick::Flickable::pixelAligned
 
@@ -1432,6 +1474,7 @@ void QQuickFlickable::componentComplete()
 void QQuickFlickable::viewportMoved(Qt::Orientations orient)
 {
     Q_D(QQuickFlickable);
+    d->cullingDirty = true;
     if (orient & Qt::Vertical)
         d->viewportAxisMoved(d->vData, minYExtent(), maxYExtent(), height(), d->fixupY_callback);
     if (orient & Qt::Horizontal)
@@ -1487,6 +1530,7 @@ void QQuickFlickable::geometryChanged(const QRectF &newGeometry,
 {
     Q_D(QQuickFlickable);
     QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    d->cullingDirty = true;
 
     bool changed = false;
     if (newGeometry.width() != oldGeometry.width()) {
@@ -1518,6 +1562,151 @@ void QQuickFlickable::geometryChanged(const QRectF &newGeometry,
         d->updateBeginningEnd();
 }
 
+void QQuickFlickable::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QQuickFlickable);
+    if (change == ItemSceneChange)
+        d->setCullingWindow(d->cullsContent ? value.window : 0);
+    QQuickItem::itemChange(change, value);
+}
+
+/*!
+    \internal
+
+    Registers the flickable with \a window, which runs cullContent() after polishing the items.
+    Passing 0 unregisters it and shows all culled content again.
+*/
+void QQuickFlickablePrivate::setCullingWindow(QQuickWindow *window)
+{
+    Q_Q(QQuickFlickable);
+    if (window == cullingWindow)
+        return;
+
+    if (cullingWindow)
+        QQuickWindowPrivate::get(cullingWindow)->cullingFlickables.removeOne(q);
+    uncullContent();
+
+    cullingWindow = window;
+    if (cullingWindow)
+        QQuickWindowPrivate::get(cullingWindow)->cullingFlickables.append(q);
+}
+
+/*!
+    \internal
+
+    Hides the items of the content which are entirely outside of the area of the content item
+    which can be seen, that is the part inside the window and, if clipping is enabled, inside
+    the flickable. Hidden items keep their scene graph nodes but are skipped by the renderer
+    and their paint nodes are not updated until they are shown again.
+
+    The content is only traversed again when the flickable was marked dirty, by moving or
+    resizing it, its content or a watched item, or when the visible area changed otherwise,
+    for instance because the window was resized or an ancestor moved.
+*/
+void QQuickFlickablePrivate::cullContent()
+{
+    Q_Q(QQuickFlickable);
+    if (!effectiveVisible || !cullingWindow)
+        return;
+
+    // Items drawn into an effect are not limited to the window.
+    for (QQuickItemPrivate *p = this; p; p = p->parentItem ? QQuickItemPrivate::get(p->parentItem) : 0) {
+        if (p->extra.isAllocated() && p->extra->effectRefCount) {
+            uncullContent();
+            return;
+        }
+    }
+
+    QRectF viewport = contentItem->mapRectFromScene(QRectF(0, 0, cullingWindow->width(), cullingWindow->height()));
+    if (q->clip())
+        viewport &= contentItem->mapRectFromItem(q, q->clipRect());
+
+    if (!cullingDirty && viewport == cullViewport)
+        return;
+    cullingDirty = false;
+    cullViewport = viewport;
+
+    ++cullPass;
+    cullContentChildren(contentItem, QTransform(), viewport, 0);
+
+    QHash<QQuickItem *, CullItem>::iterator it = cullItems.begin();
+    while (it != cullItems.end()) {
+        if (it->pass != cullPass) {
+            releaseCullItem(*it);
+            it = cullItems.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void QQuickFlickablePrivate::cullContentChildren(QQuickItem *item, const QTransform &transform,
+                                                 const QRectF &viewport, int depth)
+{
+    // Deeper hierarchies are normally the inside of a delegate, which is not worth the traversal.
+    static const int maximumDepth = 3;
+
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    for (int ii = 0; ii < itemPrivate->childItems.count(); ++ii) {
+        QQuickItem *child = itemPrivate->childItems.at(ii);
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+        if (!childPrivate->explicitVisible || qobject_cast<QQuickFlickable *>(child)
+                || (childPrivate->extra.isAllocated() && childPrivate->extra->effectRefCount)) {
+            continue;
+        }
+
+        QTransform childTransform = transform;
+        childPrivate->itemToParentTransform(childTransform);
+        // Text and images may paint outside of their size, which their bounding rect includes.
+        const QRectF rect = childTransform.mapRect(child->boundingRect());
+
+        if (viewport.contains(rect))
+            continue;
+
+        if (!viewport.intersects(rect) && (childPrivate->childItems.isEmpty() || child->clip())) {
+            trackCullItem(child, true);
+        } else if (depth < maximumDepth) {
+            // Moving the child moves the items culled below it.
+            trackCullItem(child, false);
+            cullContentChildren(child, childTransform, viewport, depth + 1);
+        }
+    }
+}
+
+void QQuickFlickablePrivate::trackCullItem(QQuickItem *item, bool culled)
+{
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    CullItem &cullItem = cullItems[item];
+    if (!cullItem.item) {
+        cullItem.item = item;
+        cullItem.culled = false;
+        itemPrivate->addItemChangeListener(this, QQuickItemPrivate::Geometry);
+    }
+    cullItem.pass = cullPass;
+    if (cullItem.culled != culled) {
+        cullItem.culled = culled;
+        itemPrivate->setViewportCulled(culled);
+    }
+}
+
+void QQuickFlickablePrivate::releaseCullItem(const CullItem &cullItem)
+{
+    if (!cullItem.item)
+        return;
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(cullItem.item);
+    itemPrivate->removeItemChangeListener(this, QQuickItemPrivate::Geometry);
+    if (cullItem.culled)
+        itemPrivate->setViewportCulled(false);
+}
+
+void QQuickFlickablePrivate::uncullContent()
+{
+    for (QHash<QQuickItem *, CullItem>::const_iterator it = cullItems.constBegin(); it != cullItems.constEnd(); ++it)
+        releaseCullItem(*it);
+    cullItems.clear();
+    cullingDirty = true;
+}
+
 /*!
     \qmlmethod QtQuick::Flickable::flick(qreal xVelocity, qreal yVelocity)
 
@@ -59,6 +59,8 @@
 
 #include <QtQml/qqml.h>
 #include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qpointer.h>
 #include "qplatformdefs.h"
 
 #include <private/qquicktimeline_p_p.h>
@@ -200,6 +202,13 @@ public:
 
     bool isViewMoving() const;
 
+    void setCullingWindow(QQuickWindow *window);
+    void cullContent();
+    void cullContentChildren(QQuickItem *item, const QTransform &transform, const QRectF &viewport, int depth);
+    void trackCullItem(QQuickItem *item, bool culled);
+    void releaseCullItem(const CullItem &cullItem);
+    void uncullContent();
+
 public:
     QQuickItem *contentItem;
 
@@ -215,6 +224,8 @@ public:
     bool calcVelocity : 1;
     bool pixelAligned : 1;
     bool replayingPressEvent : 1;
+    bool cullsContent : 1;
+    bool cullingDirty : 1;
     QElapsedTimer timer;
     qint64 lastPosTime;
     qint64 lastPressTime;
@@ -243,6 +254,17 @@ public:
     QQuickFlickable::BoundsBehavior boundsBehavior;
     QQuickTransition *rebound;
 
+    // Culled items and the items traversed to reach them, whose geometry is watched.
+    struct CullItem {
+        QPointer<QQuickItem> item;
+        int pass;
+        bool culled;
+    };
+    QHash<QQuickItem *, CullItem> cullItems;
+    QPointer<QQuickWindow> cullingWindow;
+    QRectF cullViewport;
+    int cullPass;
+
     void viewportAxisMoved(AxisData &data, qreal minExtent, qreal maxExtent, qreal vSize,
                        QQuickTimeLineCallback::Callback fixupCallback);
 
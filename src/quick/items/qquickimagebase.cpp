@@ -231,6 +231,7 @@ void QQuickImageBase::load()
 
             d->pix.connectFinished(this, thisRequestFinished);
             d->pix.connectDownloadProgress(this, thisRequestProgress);
+            d->updatePriority();
             update(); //pixmap may have invalidated texture, updatePaintNode needs to be called before the next repaint
         } else {
             requestFinished();
@@ -283,6 +284,30 @@ void QQuickImageBase::componentComplete()
         load();
 }
 
+void QQuickImageBase::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QQuickImageBase);
+    if (change == ItemVisibleHasChanged && d->pix.isLoading())
+        d->updatePriority();
+    QQuickImplicitSizeItem::itemChange(change, value);
+}
+
+void QQuickImageBasePrivate::hiddenChange()
+{
+    if (pix.isLoading())
+        updatePriority();
+}
+
+/*
+    Images which are shown are loaded before those which are hidden, for example because
+    they are in the cache buffer of a view.
+*/
+void QQuickImageBasePrivate::updatePriority()
+{
+    Q_Q(QQuickImageBase);
+    pix.setPriority(q->isVisible() && !hiddenAncestor() ? 1 : 0);
+}
+
 void QQuickImageBase::pixmapChange()
 {
     Q_D(QQuickImageBase);
@@ -99,6 +99,7 @@ protected:
     virtual void load();
     virtual void componentComplete();
     virtual void pixmapChange();
+    virtual void itemChange(ItemChange change, const ItemChangeData &value);
     QQuickImageBase(QQuickImageBasePrivate &dd, QQuickItem *parent);
 
 private Q_SLOTS:
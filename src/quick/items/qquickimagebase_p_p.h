@@ -75,6 +75,9 @@ public:
     {
     }
 
+    void updatePriority();
+    void hiddenChange();
+
     QQuickPixmap pix;
     QQuickImageBase::Status status;
     QUrl url;
@@ -2623,19 +2623,47 @@ Returns a transform that maps points from window space into item space.
 */
 QTransform QQuickItemPrivate::windowToItemTransform() const
 {
-    // XXX todo - optimize
-    return itemToWindowTransform().inverted();
+    if (windowToItemTransformDirty) {
+        QTransform itemToWindow = itemToWindowTransform();
+        windowTransforms->windowToItem = itemToWindow.inverted();
+        windowToItemTransformDirty = false;
+    }
+    return windowTransforms->windowToItem;
 }
 
 /*!
 Returns a transform that maps points from item space into window space.
+
+The result is cached until the transform of the item or one of its ancestors changes.
 */
 QTransform QQuickItemPrivate::itemToWindowTransform() const
 {
-    // XXX todo
-    QTransform rv = parentItem?QQuickItemPrivate::get(parentItem)->itemToWindowTransform():QTransform();
-    itemToParentTransform(rv);
-    return rv;
+    if (itemToWindowTransformDirty) {
+        if (!windowTransforms)
+            windowTransforms = new WindowTransforms;
+        QTransform rv = parentItem ? QQuickItemPrivate::get(parentItem)->itemToWindowTransform() : QTransform();
+        itemToParentTransform(rv);
+        windowTransforms->itemToWindow = rv;
+        itemToWindowTransformDirty = false;
+    }
+    return windowTransforms->itemToWindow;
+}
+
+/*!
+Invalidates the cached window transforms of this item and its children.
+
+A cached transform is only ever computed from the cached transform of the parent, so
+the children of an item whose cache is already invalid need not be visited.
+*/
+void QQuickItemPrivate::dirtyWindowTransforms()
+{
+    if (itemToWindowTransformDirty)
+        return;
+
+    itemToWindowTransformDirty = true;
+    windowToItemTransformDirty = true;
+    for (int ii = 0; ii < childItems.count(); ++ii)
+        QQuickItemPrivate::get(childItems.at(ii))->dirtyWindowTransforms();
 }
 
 /*!
@@ -2709,14 +2737,21 @@ QQuickItemPrivate::QQuickItemPrivate()
     , culled(false)
     , hasCursor(false)
     , activeFocusOnTab(false)
+    , viewportCulled(false)
+    , hasDeferredContent(false)
+    , itemToWindowTransformDirty(true)
+    , windowToItemTransformDirty(true)
     , dirtyAttributes(0)
     , nextDirtyItem(0)
     , prevDirtyItem(0)
+    , hiddenAncestorCache(0)
+    , hiddenAncestorPass(0)
     , window(0)
     , windowRefCount(0)
     , parentItem(0)
     , sortedChildItems(&childItems)
     , subFocusItem(0)
+    , windowTransforms(0)
     , x(0)
     , y(0)
     , width(0)
@@ -2734,6 +2769,7 @@ QQuickItemPrivate::~QQuickItemPrivate()
 {
     if (sortedChildItems != &childItems)
         delete sortedChildItems;
+    delete windowTransforms;
 }
 
 void QQuickItemPrivate::init(QQuickItem *parent)
@@ -5345,6 +5381,12 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
 
+    // The size only affects the transform through the transform origin.
+    if (type & (TransformOrigin | Transform | BasicTransform | Position | ParentChanged)
+            || (type & Size && (scale() != 1. || rotation() != 0.))) {
+        dirtyWindowTransforms();
+    }
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -5386,29 +5428,41 @@ void QQuickItemPrivate::removeFromDirtyList()
 
 void QQuickItemPrivate::refFromEffectItem(bool hide)
 {
+    bool hiddenChanged = false;
     ++extra.value().effectRefCount;
     if (1 == extra->effectRefCount) {
         dirty(EffectReference);
         if (parentItem) QQuickItemPrivate::get(parentItem)->dirty(ChildrenStackingChanged);
+        hiddenChanged = true;
     }
     if (hide) {
-        if (++extra->hideRefCount == 1)
+        if (++extra->hideRefCount == 1) {
             dirty(HideReference);
+            hiddenChanged = true;
+        }
     }
+    if (hiddenChanged)
+        hiddenAncestorChanged();
 }
 
 void QQuickItemPrivate::derefFromEffectItem(bool unhide)
 {
+    bool hiddenChanged = false;
     Q_ASSERT(extra->effectRefCount);
     --extra->effectRefCount;
     if (0 == extra->effectRefCount) {
         dirty(EffectReference);
         if (parentItem) QQuickItemPrivate::get(parentItem)->dirty(ChildrenStackingChanged);
+        hiddenChanged = true;
     }
     if (unhide) {
-        if (--extra->hideRefCount == 0)
+        if (--extra->hideRefCount == 0) {
             dirty(HideReference);
+            hiddenChanged = true;
+        }
     }
+    if (hiddenChanged)
+        hiddenAncestorChanged();
 }
 
 void QQuickItemPrivate::setCulled(bool cull)
@@ -5417,8 +5471,109 @@ void QQuickItemPrivate::setCulled(bool cull)
         return;
 
     culled = cull;
-    if ((cull && ++extra.value().hideRefCount == 1) || (!cull && --extra.value().hideRefCount == 0))
+    if ((cull && ++extra.value().hideRefCount == 1) || (!cull && --extra.value().hideRefCount == 0)) {
         dirty(HideReference);
+        if (!cull)
+            updateDeferredContent();
+        hiddenAncestorChanged();
+    }
+}
+
+/*!
+    Hides the item because it is outside of the visible area of a viewport such as a Flickable.
+
+    This is tracked separately from culled, which the item views use for their own bookkeeping
+    of buffered delegates, so that both can hide the same item independently.
+*/
+void QQuickItemPrivate::setViewportCulled(bool cull)
+{
+    if (cull == viewportCulled)
+        return;
+
+    viewportCulled = cull;
+    if ((cull && ++extra.value().hideRefCount == 1) || (!cull && --extra.value().hideRefCount == 0)) {
+        dirty(HideReference);
+        if (!cull)
+            updateDeferredContent();
+        hiddenAncestorChanged();
+    }
+}
+
+/*!
+    Returns the closest item in the parent chain, including this item, which is hidden from the
+    scene graph, or 0 if the item is rendered.
+
+    Items referenced by an effect are always rendered, so are their children.
+
+    When \a pass is not 0, the result is cached on this item and its ancestors and returned
+    for later calls with the same \a pass, so that the parent chain is only walked once. The
+    caller must make sure that no item is hidden or shown while the same pass is in use.
+*/
+QQuickItemPrivate *QQuickItemPrivate::hiddenAncestor(quint32 pass)
+{
+    if (pass && hiddenAncestorPass == pass)
+        return hiddenAncestorCache;
+
+    QQuickItemPrivate *hidden = 0;
+    if (extra.isAllocated() && extra->effectRefCount)
+        hidden = 0;
+    else if (extra.isAllocated() && extra->hideRefCount)
+        hidden = this;
+    else if (parentItem)
+        hidden = QQuickItemPrivate::get(parentItem)->hiddenAncestor(pass);
+
+    hiddenAncestorCache = hidden;
+    hiddenAncestorPass = pass;
+    return hidden;
+}
+
+static void hiddenAncestorChangedRecursive(QQuickItemPrivate *d)
+{
+    d->hiddenChange();
+
+    for (int ii = 0; ii < d->childItems.count(); ++ii) {
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(d->childItems.at(ii));
+        // Children which are hidden or referenced by an effect themselves are not affected.
+        if (childPrivate->extra.isAllocated()
+                && (childPrivate->extra->hideRefCount || childPrivate->extra->effectRefCount)) {
+            continue;
+        }
+        hiddenAncestorChangedRecursive(childPrivate);
+    }
+}
+
+/*!
+    Lets this item and its descendants react with hiddenChange() to a change of the hidden
+    state of this item, which may change what hiddenAncestor() returns for them.
+*/
+void QQuickItemPrivate::hiddenAncestorChanged()
+{
+    hiddenAncestorChangedRecursive(this);
+}
+
+static void updateDeferredContentRecursive(QQuickItemPrivate *d)
+{
+    if (d->window && !d->prevDirtyItem && (d->dirtyAttributes & QQuickItemPrivate::ContentUpdateMask))
+        d->addToDirtyList();
+
+    for (int ii = 0; ii < d->childItems.count(); ++ii) {
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(d->childItems.at(ii));
+        // Items which are still hidden keep track of their own deferred content.
+        if (childPrivate->extra.isAllocated() && childPrivate->extra->hideRefCount)
+            continue;
+        updateDeferredContentRecursive(childPrivate);
+    }
+}
+
+/*!
+    Schedules the paint node updates which were skipped while this item was hidden.
+*/
+void QQuickItemPrivate::updateDeferredContent()
+{
+    if (!hasDeferredContent)
+        return;
+    hasDeferredContent = false;
+    updateDeferredContentRecursive(this);
 }
 
 void QQuickItemPrivate::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data)
@@ -422,6 +422,10 @@ public:
     bool hasCursor:1;
     // Bit 32
     bool activeFocusOnTab:1;
+    bool viewportCulled:1;
+    bool hasDeferredContent:1;
+    mutable bool itemToWindowTransformDirty:1;
+    mutable bool windowToItemTransformDirty:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -464,6 +468,12 @@ public:
     QQuickItem**prevDirtyItem;
 
     void setCulled(bool);
+    void setViewportCulled(bool);
+    QQuickItemPrivate *hiddenAncestor(quint32 pass = 0);
+    void hiddenAncestorChanged();
+    void updateDeferredContent();
+    QQuickItemPrivate *hiddenAncestorCache;
+    quint32 hiddenAncestorPass;
 
     QQuickWindow *window;
     int windowRefCount;
@@ -491,6 +501,15 @@ public:
     QTransform windowToItemTransform() const;
     QTransform itemToWindowTransform() const;
     void itemToParentTransform(QTransform &) const;
+    void dirtyWindowTransforms();
+
+    // Cached results of windowToItemTransform() and itemToWindowTransform(), allocated
+    // the first time either is requested.
+    struct WindowTransforms {
+        QTransform itemToWindow;
+        QTransform windowToItem;
+    };
+    mutable WindowTransforms *windowTransforms;
 
     static bool focusNextPrev(QQuickItem *item, bool forward);
     static QQuickItem *nextPrevItemInTabFocusChain(QQuickItem *item, bool forward);
@@ -577,6 +596,7 @@ public:
     void itemChange(QQuickItem::ItemChange, const QQuickItem::ItemChangeData &);
 
     virtual void mirrorChange() {}
+    virtual void hiddenChange() {}
 
     void incrementCursorCount(int delta);
 };
@@ -268,6 +268,9 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
 
     qmlRegisterType<QQuickText, 2>(uri, 2, 2, "Text");
     qmlRegisterType<QQuickTextEdit, 2>(uri, 2, 2, "TextEdit");
+
+    qmlRegisterType<QQuickText, 3>(uri, 2, 3, "Text");
+    qmlRegisterType<QQuickFlickable, 1>(uri, 2, 3, "Flickable");
 }
 
 static void initResources()
@@ -53,6 +53,7 @@
 
 #include <QtQml/qqmlinfo.h>
 #include <QtGui/qevent.h>
+#include <QtGui/qfontdatabase.h>
 #include <QtGui/qabstracttextdocumentlayout.h>
 #include <QtGui/qpainter.h>
 #include <QtGui/qtextdocument.h>
@@ -60,6 +61,7 @@
 #include <QtGui/qtextcursor.h>
 #include <QtGui/qguiapplication.h>
 #include <QtGui/qinputmethod.h>
+#include <QtCore/qthreadpool.h>
 
 #include <private/qtextengine_p.h>
 #include <private/qquickstyledtext_p.h>
@@ -87,12 +89,16 @@ QQuickTextPrivate::QQuickTextPrivate()
     , requireImplicitSize(false), implicitWidthValid(false), implicitHeightValid(false)
     , truncated(false), hAlignImplicit(true), rightToLeftText(false)
     , layoutTextElided(false), textHasChanged(true), needToUpdateLayout(false), formatModifiesFontSize(false)
+    , asynchronous(false)
 {
 }
 
 QQuickTextPrivate::ExtraData::ExtraData()
     : lineHeight(1.0)
     , doc(0)
+    , asyncLayout(0)
+    , layoutJob(0)
+    , layoutSerial(0)
     , minimumPixelSize(12)
     , minimumPointSize(12)
     , nbActiveDownloads(0)
@@ -269,6 +275,11 @@ QSet<QUrl> QQuickTextDocumentWithImageResources::errors;
 
 QQuickTextPrivate::~QQuickTextPrivate()
 {
+    if (extra.isAllocated()) {
+        if (extra->layoutJob)
+            extra->layoutJob->cancel();
+        delete extra->asyncLayout;
+    }
     delete elideLayout;
     delete textLine; textLine = 0;
     qDeleteAll(imgTags);
@@ -367,6 +378,20 @@ void QQuickTextPrivate::updateLayout()
     }
 }
 
+void QQuickText::q_asynchronousLayoutFinished(int serial)
+{
+    Q_D(QQuickText);
+    // The finished job may since have been cancelled and deleted, and its address reused by a
+    // newer job, so it is identified by its serial number rather than the sender.
+    if (!d->extra.isAllocated() || !d->extra->layoutJob || d->extra->layoutSerial != serial)
+        return; // Superseded by a newer layout, the job has already been released.
+
+    QQuickTextLayoutJob *job = d->extra->layoutJob;
+    d->extra->layoutJob = 0;
+    d->finishAsynchronousLayout(job);
+    job->release();
+}
+
 void QQuickText::imageDownloadFinished()
 {
     Q_D(QQuickText);
@@ -430,6 +455,8 @@ void QQuickTextPrivate::updateSize()
     }
 
     if (text.isEmpty() && !isLineLaidOutConnected() && fontSizeMode() == QQuickText::FixedSize) {
+        discardAsynchronousLayout();    // A pending layout of the previous text must not land.
+
         // How much more expensive is it to just do a full layout on an empty string here?
         // There may be subtle differences in the height and baseline calculations between
         // QTextLayout and QFontMetrics and the number of variables that can affect the size
@@ -454,6 +481,14 @@ void QQuickTextPrivate::updateSize()
     QSizeF previousSize = layedOutTextRect.size();
 
     //setup instance of QTextLayout for all cases other than richtext
+    if (!richText && canLayoutAsynchronously()) {
+        // The current layout remains on screen until the job delivers a new one.
+        startAsynchronousLayout();
+        return;
+    }
+
+    discardAsynchronousLayout();
+
     if (!richText) {
         qreal baseline = 0;
         QRectF textRect = setupTextLayout(&baseline);
@@ -1185,6 +1220,224 @@ void QQuickTextPrivate::ensureDoc()
     }
 }
 
+/*!
+    Returns true if the text can be laid out by a QQuickTextLayoutJob.
+
+    Only the plain line breaking done by setLineGeometry() is reproduced off the GUI thread,
+    anything that needs to run QML (lineLaidOut), load images or iteratively refit the text
+    (eliding, font size fitting, maximum line count) is still laid out synchronously, as is all
+    text on platforms whose font engines can't be used from other threads.
+*/
+bool QQuickTextPrivate::canLayoutAsynchronously()
+{
+    return asynchronous
+            && QFontDatabase::supportsThreadedFontRendering()
+            && !richText
+            && elideMode == QQuickText::ElideNone
+            && fontSizeMode() == QQuickText::FixedSize
+            && !maximumLineCountValid
+            && multilengthEos == -1
+            && imgTags.isEmpty()
+            && !isLineLaidOutConnected();
+}
+
+/*
+    Returns a copy of \a font that shares no data with it.
+
+    Copies of a QFont share a QFontPrivate, and with it the font engines the GUI thread looks
+    up, so a layout job must not use the item's font directly.  Changing a property detaches
+    the font: the first change gives the copy its own QFontPrivate, the second, which restores
+    the original value, drops the small caps font that QFontPrivate copies still share.
+*/
+static QFont detachedFont(const QFont &font)
+{
+    QFont copy(font);
+    copy.setStyleStrategy(QFont::StyleStrategy(font.styleStrategy() ^ QFont::NoAntialias));
+    copy.setStyleStrategy(font.styleStrategy());
+    return copy;
+}
+
+void QQuickTextPrivate::startAsynchronousLayout()
+{
+    Q_Q(QQuickText);
+
+    if (extra.isAllocated() && extra->layoutJob) {
+        extra->layoutJob->cancel();
+        extra->layoutJob = 0;
+    }
+
+    QQuickTextLayoutJob *job = new QQuickTextLayoutJob;
+    job->text = layout.text();
+    job->formats = layout.additionalFormats();
+    job->font = detachedFont(font);
+    job->textOption.setAlignment(Qt::Alignment(q->effectiveHAlign()));
+    job->textOption.setWrapMode(QTextOption::WrapMode(wrapMode));
+    job->textOption.setUseDesignMetrics(renderType != QQuickText::NativeRendering);
+    job->lineWidth = (q->widthValid() || implicitWidthValid) && q->width() > 0
+            ? q->width()
+            : FLT_MAX;
+    job->lineHeight = lineHeight();
+    job->lineHeightMode = lineHeightMode();
+
+    qmlobject_connect(job, QQuickTextLayoutJob, SIGNAL(finished(int)),
+                      q, QQuickText, SLOT(q_asynchronousLayoutFinished(int)));
+
+    job->serial = ++extra.value().layoutSerial;
+    extra->layoutJob = job;
+    QThreadPool::globalInstance()->start(job);
+}
+
+void QQuickTextPrivate::finishAsynchronousLayout(QQuickTextLayoutJob *job)
+{
+    Q_Q(QQuickText);
+
+    const QSizeF previousSize = layedOutTextRect.size();
+    const bool wasTruncated = truncated;
+
+    delete extra->asyncLayout;
+    extra->asyncLayout = job->takeLayout();
+    delete elideLayout;
+    elideLayout = 0;
+
+    lineWidth = job->lineWidth;
+    widthExceeded = job->naturalWidth > job->lineWidth;
+    heightExceeded = false;
+    truncated = false;
+
+    const bool wasInLayout = internalWidthUpdate;
+    internalWidthUpdate = true;
+    q->setImplicitSize(job->naturalWidth, job->boundingRect.height());
+    internalWidthUpdate = wasInLayout;
+    implicitWidthValid = true;
+    implicitHeightValid = true;
+
+    layedOutTextRect = job->boundingRect;
+    updateBaseline(job->baseline, q->height() - layedOutTextRect.height());
+
+    if (lineCount != job->lineCount) {
+        lineCount = job->lineCount;
+        emit q->lineCountChanged();
+    }
+    if (truncated != wasTruncated)
+        emit q->truncatedChanged();
+    if (layedOutTextRect.size() != previousSize)
+        emit q->contentSizeChanged();
+
+    updateType = UpdatePaintNode;
+    q->update();
+}
+
+void QQuickTextPrivate::discardAsynchronousLayout()
+{
+    if (!extra.isAllocated())
+        return;
+    if (extra->layoutJob) {
+        extra->layoutJob->cancel();
+        extra->layoutJob = 0;
+    }
+    delete extra->asyncLayout;
+    extra->asyncLayout = 0;
+}
+
+QQuickTextLayoutJob::QQuickTextLayoutJob()
+    : lineWidth(FLT_MAX), lineHeight(1.0), lineHeightMode(QQuickText::ProportionalHeight)
+    , serial(0), naturalWidth(0), baseline(0), lineCount(0)
+    , m_layout(0), m_ref(2), m_cancelled(0)
+{
+    setAutoDelete(false);
+}
+
+QQuickTextLayoutJob::~QQuickTextLayoutJob()
+{
+    delete m_layout;
+}
+
+/*!
+    Lays out the text on a thread pool thread.
+
+    The job is referenced by both the thread running it and the item that started it, and is
+    deleted once both have released it.
+*/
+void QQuickTextLayoutJob::run()
+{
+    QTextLayout *textLayout = new QTextLayout(text, font);
+    textLayout->setCacheEnabled(true);
+    textLayout->setTextOption(textOption);
+    textLayout->setAdditionalFormats(formats);
+
+    layoutLines(textLayout, lineWidth);
+    naturalWidth = textLayout->maximumWidth();
+
+    if (lineWidth == FLT_MAX) {
+        // Without a width lines are aligned against the widest line, do another layout now
+        // that it is known.
+        lineWidth = naturalWidth;
+        if (textOption.alignment() != Qt::AlignLeft)
+            layoutLines(textLayout, lineWidth);
+    } else if (textOption.wrapMode() != QTextOption::NoWrap) {
+        // The implicit width is the width of the text when it isn't wrapped.
+        QTextOption unwrappedOption = textOption;
+        unwrappedOption.setWrapMode(QTextOption::NoWrap);
+        QTextLayout unwrapped(text, font);
+        unwrapped.setTextOption(unwrappedOption);
+        unwrapped.setAdditionalFormats(formats);
+        unwrapped.beginLayout();
+        while (unwrapped.createLine().isValid()) {}
+        unwrapped.endLayout();
+        naturalWidth = unwrapped.maximumWidth();
+    }
+
+    lineCount = textLayout->lineCount();
+    const QTextLine firstLine = textLayout->lineAt(0);
+    baseline = firstLine.isValid() ? firstLine.y() + firstLine.ascent() : 0;
+
+    m_layout = textLayout;
+    if (!m_cancelled.load())
+        emit finished(serial);
+    release();
+}
+
+/*!
+    Detaches the job from the item that started it, the item must not access the job again.
+*/
+void QQuickTextLayoutJob::cancel()
+{
+    m_cancelled.store(1);
+    release();
+}
+
+void QQuickTextLayoutJob::release()
+{
+    if (!m_ref.deref())
+        deleteLater();
+}
+
+QTextLayout *QQuickTextLayoutJob::takeLayout()
+{
+    QTextLayout *textLayout = m_layout;
+    m_layout = 0;
+    return textLayout;
+}
+
+void QQuickTextLayoutJob::layoutLines(QTextLayout *textLayout, qreal width)
+{
+    qreal height = 0;
+    QRectF br;
+
+    textLayout->beginLayout();
+    for (QTextLine line = textLayout->createLine(); line.isValid(); line = textLayout->createLine()) {
+        line.setLineWidth(width);
+        line.setPosition(QPointF(line.position().x(), height));
+        height += lineHeightMode == QQuickText::FixedHeight ? lineHeight : line.height() * lineHeight;
+        br = br.united(line.naturalTextRect());
+    }
+    textLayout->endLayout();
+
+    br.moveTop(0);
+    br.setHeight(height);
+    boundingRect = br;
+}
+
 /*!
     \qmltype Text
     \instantiates QQuickText
@@ -2218,7 +2471,7 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         if (unelidedLineCount > 0) {
             node->addTextLayout(
                         QPointF(dx, dy),
-                        &d->layout,
+                        d->displayedLayout(),
                         color, d->style, styleColor, linkColor,
                         QColor(), QColor(), -1, -1,
                         0, unelidedLineCount);
@@ -2482,7 +2735,7 @@ QString QQuickTextPrivate::anchorAt(const QPointF &mousePos) const
     QPointF translatedMousePos = mousePos;
     translatedMousePos.ry() -= QQuickTextUtil::alignedY(layedOutTextRect.height(), q->height(), vAlign);
     if (styledText) {
-        QString link = anchorAt(&layout, translatedMousePos);
+        QString link = anchorAt(displayedLayout(), translatedMousePos);
         if (link.isEmpty() && elideLayout)
             link = anchorAt(elideLayout, translatedMousePos);
         return link;
@@ -2658,6 +2911,44 @@ void QQuickText::setRenderType(QQuickText::RenderType renderType)
         d->updateLayout();
 }
 
+/*!
+    \qmlproperty bool QtQuick::Text::asynchronous
+    \since QtQuick 2.3
+
+    Specifies that the text should be laid out on a separate thread.
+
+    Shaping and line breaking of long text can take a noticeable amount of time. When
+    \c asynchronous is true the layout is done in the background and the previously laid out
+    text remains visible until the new layout is ready. Size properties such as
+    \l contentWidth, \l contentHeight, \l lineCount and the implicit size are only updated once
+    the layout has finished.
+
+    Asynchronous layout is not used for rich text, elided text, text with a
+    \l maximumLineCount, text with inline images, text which is scaled to fit using
+    \l fontSizeMode, or text with a handler for the \l lineLaidOut signal; such text is
+    always laid out synchronously.
+
+    The default value is false.
+*/
+bool QQuickText::asynchronous() const
+{
+    Q_D(const QQuickText);
+    return d->asynchronous;
+}
+
+void QQuickText::setAsynchronous(bool asynchronous)
+{
+    Q_D(QQuickText);
+    if (d->asynchronous == asynchronous)
+        return;
+
+    d->asynchronous = asynchronous;
+    emit asynchronousChanged();
+
+    if (isComponentComplete())
+        d->updateSize();
+}
+
 /*!
     \qmlmethod QtQuick::Text::doLayout()
 
@@ -91,6 +91,7 @@ class Q_QUICK_PRIVATE_EXPORT QQuickText : public QQuickImplicitSizeItem
     Q_PROPERTY(FontSizeMode fontSizeMode READ fontSizeMode WRITE setFontSizeMode NOTIFY fontSizeModeChanged)
     Q_PROPERTY(RenderType renderType READ renderType WRITE setRenderType NOTIFY renderTypeChanged)
     Q_PROPERTY(QString hoveredLink READ hoveredLink NOTIFY linkHovered REVISION 2)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged REVISION 3)
 
 public:
     QQuickText(QQuickItem *parent=0);
@@ -210,6 +211,9 @@ public:
 
     QString hoveredLink() const;
 
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
 Q_SIGNALS:
     void textChanged(const QString &text);
     void linkActivated(const QString &link);
@@ -237,6 +241,7 @@ Q_SIGNALS:
     void lineLaidOut(QQuickTextLine *line);
     void baseUrlChanged();
     void renderTypeChanged();
+    Q_REVISION(3) void asynchronousChanged();
 
 protected:
     void mousePressEvent(QMouseEvent *event);
@@ -255,6 +260,7 @@ private Q_SLOTS:
     void q_imagesLoaded();
     void triggerPreprocess();
     void imageDownloadFinished();
+    void q_asynchronousLayoutFinished(int serial);
 
 private:
     Q_DISABLE_COPY(QQuickText)
@@ -59,6 +59,8 @@
 #include <QtQml/qqml.h>
 #include <QtGui/qabstracttextdocumentlayout.h>
 #include <QtGui/qtextlayout.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qrunnable.h>
 #include <private/qquickstyledtext_p.h>
 #include <private/qlazilyallocated_p.h>
 
@@ -66,6 +68,7 @@ QT_BEGIN_NAMESPACE
 
 class QTextLayout;
 class QQuickTextDocumentWithImageResources;
+class QQuickTextLayoutJob;
 
 class Q_AUTOTEST_EXPORT QQuickTextPrivate : public QQuickImplicitSizeItemPrivate
 {
@@ -89,6 +92,11 @@ public:
 
     void processHoverEvent(QHoverEvent *event);
 
+    bool canLayoutAsynchronously();
+    void startAsynchronousLayout();
+    void finishAsynchronousLayout(QQuickTextLayoutJob *job);
+    void discardAsynchronousLayout();
+
     QRectF layedOutTextRect;
 
     struct ExtraData {
@@ -96,6 +104,9 @@ public:
 
         qreal lineHeight;
         QQuickTextDocumentWithImageResources *doc;
+        QTextLayout *asyncLayout;
+        QQuickTextLayoutJob *layoutJob;
+        int layoutSerial;
         QString activeLink;
         QString hoveredLink;
         int minimumPixelSize;
@@ -159,6 +170,7 @@ public:
     bool textHasChanged:1;
     bool needToUpdateLayout:1;
     bool formatModifiesFontSize:1;
+    bool asynchronous:1;
 
     static const QChar elideChar;
 
@@ -174,6 +186,8 @@ public:
     static QString anchorAt(const QTextLayout *layout, const QPointF &mousePos);
     QString anchorAt(const QPointF &pos) const;
 
+    inline QTextLayout *displayedLayout() { return extra.isAllocated() && extra->asyncLayout ? extra->asyncLayout : &layout; }
+    inline const QTextLayout *displayedLayout() const { return extra.isAllocated() && extra->asyncLayout ? extra->asyncLayout : &layout; }
     inline qreal lineHeight() const { return extra.isAllocated() ? extra->lineHeight : 1.0; }
     inline int maximumLineCount() const { return extra.isAllocated() ? extra->maximumLineCount : INT_MAX; }
     inline QQuickText::LineHeightMode lineHeightMode() const { return extra.isAllocated() ? extra->lineHeightMode : QQuickText::ProportionalHeight; }
@@ -225,6 +239,46 @@ private:
     static QSet<QUrl> errors;
 };
 
+class QQuickTextLayoutJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    QQuickTextLayoutJob();
+    ~QQuickTextLayoutJob();
+
+    void run();
+    void cancel();
+    void release();
+
+    QTextLayout *takeLayout();
+
+    // Inputs, set on the GUI thread before the job is started.
+    QString text;
+    QList<QTextLayout::FormatRange> formats;
+    QFont font;
+    QTextOption textOption;
+    qreal lineWidth;
+    qreal lineHeight;
+    QQuickText::LineHeightMode lineHeightMode;
+    int serial;
+
+    // Results, only valid once finished() has been emitted.
+    QRectF boundingRect;
+    qreal naturalWidth;
+    qreal baseline;
+    int lineCount;
+
+Q_SIGNALS:
+    void finished(int serial);
+
+private:
+    void layoutLines(QTextLayout *textLayout, qreal width);
+
+    QTextLayout *m_layout;
+    QAtomicInt m_ref;
+    QAtomicInt m_cancelled;
+};
+
 QT_END_NAMESPACE
 
 #endif // QQUICKTEXT_P_P_H
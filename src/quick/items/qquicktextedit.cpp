@@ -127,6 +127,10 @@ TextEdit {
 // into text nodes corresponding to a text block each so that the glyph node grouping doesn't become pointless.
 static const int nodeBreakingSize = 300;
 
+// Documents with more characters than this only get glyph nodes for the blocks close to the
+// visible part of the item.
+static const int largeTextSizeThreshold = 10000;
+
 namespace {
     class ProtectedLayoutAccessor: public QAbstractTextDocumentLayout
     {
@@ -176,6 +180,12 @@ QQuickTextEdit::QQuickTextEdit(QQuickItem *parent)
     d->init();
 }
 
+QQuickTextEdit::~QQuickTextEdit()
+{
+    Q_D(QQuickTextEdit);
+    d->unwatchViewportAncestors();
+}
+
 QString QQuickTextEdit::text() const
 {
     Q_D(const QQuickTextEdit);
@@ -1269,7 +1279,17 @@ void QQuickTextEdit::geometryChanged(const QRectF &newGeometry,
         moveCursorDelegate();
     }
     QQuickImplicitSizeItem::geometryChanged(newGeometry, oldGeometry);
+    d->updateViewport();
+}
 
+void QQuickTextEdit::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QQuickTextEdit);
+    if (change == ItemParentHasChanged && d->observesViewport) {
+        d->watchViewportAncestors();
+        d->updateViewport();
+    }
+    QQuickImplicitSizeItem::itemChange(change, value);
 }
 
 /*!
@@ -1773,129 +1793,153 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
         d->textNodeMap.clear();
 
     RootNode *rootNode = static_cast<RootNode *>(oldNode);
-    TextNodeIterator nodeIterator = d->textNodeMap.begin();
-    while (nodeIterator != d->textNodeMap.end() && !(*nodeIterator)->dirty())
-        ++nodeIterator;
-
+    TextNodeIterator nodeIterator = d->firstDirtyTextNode();
 
     if (!oldNode || nodeIterator < d->textNodeMap.end()) {
 
         if (!oldNode)
             rootNode = new RootNode;
 
-        int firstDirtyPos = 0;
-        if (nodeIterator != d->textNodeMap.end()) {
-            firstDirtyPos = (*nodeIterator)->startPos();
-            do {
-                rootNode->removeChildNode((*nodeIterator)->textNode());
-                delete (*nodeIterator)->textNode();
-                delete *nodeIterator;
-                nodeIterator = d->textNodeMap.erase(nodeIterator);
-            } while (nodeIterator != d->textNodeMap.end() && (*nodeIterator)->dirty());
-        }
-
         // FIXME: the text decorations could probably be handled separately (only updated for affected textFrames)
         rootNode->resetFrameDecorations(d->createTextNode());
 
-        QQuickTextNode *node = 0;
-
-        int currentNodeSize = 0;
-        int nodeStart = firstDirtyPos;
-        QPointF basePosition(d->xoff, d->yoff);
-        QPointF nodeOffset;
-        TextNode *firstCleanNode = (nodeIterator != d->textNodeMap.end()) ? *nodeIterator : 0;
-
-        QList<QTextFrame *> frames;
-        frames.append(d->document->rootFrame());
-
-        while (!frames.isEmpty()) {
-            QTextFrame *textFrame = frames.takeFirst();
-            frames.append(textFrame->childFrames());
-            rootNode->frameDecorationsNode->m_engine->addFrameDecorations(d->document, textFrame);
-
-
-            if (textFrame->lastPosition() < firstDirtyPos || (firstCleanNode && textFrame->firstPosition() >= firstCleanNode->startPos()))
-                continue;
-            node = d->createTextNode();
-
-            if (textFrame->firstPosition() > textFrame->lastPosition()
-                    && textFrame->frameFormat().position() != QTextFrameFormat::InFlow) {
-                updateNodeTransform(node, d->document->documentLayout()->frameBoundingRect(textFrame).topLeft());
-                const int pos = textFrame->firstPosition() - 1;
-                ProtectedLayoutAccessor *a = static_cast<ProtectedLayoutAccessor *>(d->document->documentLayout());
-                QTextCharFormat format = a->formatAccessor(pos);
-                QTextBlock block = textFrame->firstCursorPosition().block();
-                node->m_engine->setCurrentLine(block.layout()->lineForTextPosition(pos - block.position()));
-                node->m_engine->addTextObject(QPointF(0, 0), format, QQuickTextNodeEngine::Unselected, d->document,
-                                              pos, textFrame->frameFormat().position());
-                nodeStart = pos;
-            } else if (qobject_cast<QTextTable*>(textFrame)) { // To keep things simple, map text tables as one text node
-                QTextFrame::iterator it = textFrame->begin();
-                nodeOffset =  d->document->documentLayout()->frameBoundingRect(textFrame).topLeft();
-                updateNodeTransform(node, nodeOffset);
-                while (!it.atEnd())
-                    node->m_engine->addTextBlock(d->document, (it++).currentBlock(), basePosition - nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
-                nodeStart = textFrame->firstPosition();
-            } else {
-                // Having nodes spanning across frame boundaries will break the current bookkeeping mechanism. We need to prevent that.
-                QList<int> frameBoundaries;
-                frameBoundaries.reserve(frames.size());
-                Q_FOREACH (QTextFrame *frame, frames)
-                    frameBoundaries.append(frame->firstPosition());
-                std::sort(frameBoundaries.begin(), frameBoundaries.end());
-
-                QTextFrame::iterator it = textFrame->begin();
-                while (!it.atEnd()) {
-                    QTextBlock block = it.currentBlock();
-                    ++it;
-                    if (block.position() < firstDirtyPos)
-                        continue;
-
-                    if (!node->m_engine->hasContents()) {
-                        nodeOffset = d->document->documentLayout()->blockBoundingRect(block).topLeft();
-                        updateNodeTransform(node, nodeOffset);
-                        nodeStart = block.position();
-                    }
-
-                    node->m_engine->addTextBlock(d->document, block, basePosition - nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
-                    currentNodeSize += block.length();
-
-                    if ((it.atEnd()) || (firstCleanNode && block.next().position() >= firstCleanNode->startPos())) // last node that needed replacing or last block of the frame
-                        break;
+        // Blocks outside of this rectangle are not given any glyph nodes, their text nodes are
+        // flagged as culled and regenerated once the viewport moves over them.
+        const bool cull = d->observesViewport;
+        const QRectF cullRect = cull ? d->viewportCullRect() : QRectF();
+        d->renderedViewport = cullRect;
+
+        bool addFrameDecorations = true;
+
+        // Each pass regenerates one contiguous run of dirty nodes.
+        do {
+            int firstDirtyPos = 0;
+            if (nodeIterator != d->textNodeMap.end()) {
+                firstDirtyPos = (*nodeIterator)->startPos();
+                do {
+                    rootNode->removeChildNode((*nodeIterator)->textNode());
+                    delete (*nodeIterator)->textNode();
+                    delete *nodeIterator;
+                    nodeIterator = d->textNodeMap.erase(nodeIterator);
+                } while (nodeIterator != d->textNodeMap.end() && (*nodeIterator)->dirty());
+            }
 
-                    QList<int>::const_iterator lowerBound = std::lower_bound(frameBoundaries.constBegin(), frameBoundaries.constEnd(), block.next().position());
-                    if (currentNodeSize > nodeBreakingSize || lowerBound == frameBoundaries.constEnd() || *lowerBound > nodeStart) {
-                        currentNodeSize = 0;
-                        d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart);
-                        node = d->createTextNode();
-                        nodeStart = block.next().position();
+            QQuickTextNode *node = 0;
+
+            int currentNodeSize = 0;
+            int nodeStart = firstDirtyPos;
+            QPointF basePosition(d->xoff, d->yoff);
+            QPointF nodeOffset;
+            TextNode *firstCleanNode = (nodeIterator != d->textNodeMap.end()) ? *nodeIterator : 0;
+
+            QList<QTextFrame *> frames;
+            frames.append(d->document->rootFrame());
+
+            while (!frames.isEmpty()) {
+                QTextFrame *textFrame = frames.takeFirst();
+                frames.append(textFrame->childFrames());
+                if (addFrameDecorations)
+                    rootNode->frameDecorationsNode->m_engine->addFrameDecorations(d->document, textFrame);
+
+
+                if (textFrame->lastPosition() < firstDirtyPos || (firstCleanNode && textFrame->firstPosition() >= firstCleanNode->startPos()))
+                    continue;
+                node = d->createTextNode();
+                bool nodeCulled = false;
+
+                if (textFrame->firstPosition() > textFrame->lastPosition()
+                        && textFrame->frameFormat().position() != QTextFrameFormat::InFlow) {
+                    updateNodeTransform(node, d->document->documentLayout()->frameBoundingRect(textFrame).topLeft());
+                    const int pos = textFrame->firstPosition() - 1;
+                    ProtectedLayoutAccessor *a = static_cast<ProtectedLayoutAccessor *>(d->document->documentLayout());
+                    QTextCharFormat format = a->formatAccessor(pos);
+                    QTextBlock block = textFrame->firstCursorPosition().block();
+                    node->m_engine->setCurrentLine(block.layout()->lineForTextPosition(pos - block.position()));
+                    node->m_engine->addTextObject(QPointF(0, 0), format, QQuickTextNodeEngine::Unselected, d->document,
+                                                  pos, textFrame->frameFormat().position());
+                    nodeStart = pos;
+                } else if (qobject_cast<QTextTable*>(textFrame)) { // To keep things simple, map text tables as one text node
+                    QTextFrame::iterator it = textFrame->begin();
+                    nodeOffset =  d->document->documentLayout()->frameBoundingRect(textFrame).topLeft();
+                    updateNodeTransform(node, nodeOffset);
+                    while (!it.atEnd())
+                        node->m_engine->addTextBlock(d->document, (it++).currentBlock(), basePosition - nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
+                    nodeStart = textFrame->firstPosition();
+                } else {
+                    // Having nodes spanning across frame boundaries will break the current bookkeeping mechanism. We need to prevent that.
+                    QList<int> frameBoundaries;
+                    frameBoundaries.reserve(frames.size());
+                    Q_FOREACH (QTextFrame *frame, frames)
+                        frameBoundaries.append(frame->firstPosition());
+                    std::sort(frameBoundaries.begin(), frameBoundaries.end());
+
+                    QTextFrame::iterator it = textFrame->begin();
+                    while (!it.atEnd()) {
+                        QTextBlock block = it.currentBlock();
+                        ++it;
+                        if (block.position() < firstDirtyPos)
+                            continue;
+
+                        const QRectF blockRect = d->document->documentLayout()->blockBoundingRect(block);
+                        if (!node->m_engine->hasContents() && !nodeCulled) {
+                            nodeOffset = blockRect.topLeft();
+                            updateNodeTransform(node, nodeOffset);
+                            nodeStart = block.position();
+                        }
+
+                        if (!cull || (!cullRect.isEmpty()
+                                && blockRect.bottom() + d->yoff >= cullRect.top()
+                                && blockRect.top() + d->yoff <= cullRect.bottom())) {
+                            node->m_engine->addTextBlock(d->document, block, basePosition - nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
+                        } else {
+                            nodeCulled = true;
+                        }
+                        currentNodeSize += block.length();
+
+                        if ((it.atEnd()) || (firstCleanNode && block.next().position() >= firstCleanNode->startPos())) // last node that needed replacing or last block of the frame
+                            break;
+
+                        QList<int>::const_iterator lowerBound = std::lower_bound(frameBoundaries.constBegin(), frameBoundaries.constEnd(), block.next().position());
+                        if (currentNodeSize > nodeBreakingSize || lowerBound == frameBoundaries.constEnd() || *lowerBound > nodeStart) {
+                            currentNodeSize = 0;
+                            d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart, nodeCulled);
+                            node = d->createTextNode();
+                            nodeCulled = false;
+                            nodeStart = block.next().position();
+                        }
                     }
                 }
+                d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart, nodeCulled);
             }
-            d->addCurrentTextNodeToRoot(rootNode, node, nodeIterator, nodeStart);
-        }
-        rootNode->frameDecorationsNode->m_engine->addToSceneGraph(rootNode->frameDecorationsNode, QQuickText::Normal, QColor());
-        // Now prepend the frame decorations since we want them rendered first, with the text nodes and cursor in front.
-        rootNode->prependChildNode(rootNode->frameDecorationsNode);
+            addFrameDecorations = false;
+
+            Q_ASSERT(nodeIterator == d->textNodeMap.end() || (*nodeIterator) == firstCleanNode);
+            // Update the position of the subsequent text blocks.
+            if (firstCleanNode) {
+                QPointF oldOffset = firstCleanNode->textNode()->matrix().map(QPointF(0,0));
+                QPointF currentOffset = d->document->documentLayout()->blockBoundingRect(d->document->findBlock(firstCleanNode->startPos())).topLeft();
+                QPointF delta = currentOffset - oldOffset;
+                while (nodeIterator != d->textNodeMap.end()) {
+                    if ((*nodeIterator)->dirty())
+                        break; // Moved when its own run is regenerated.
+                    QMatrix4x4 transformMatrix = (*nodeIterator)->textNode()->matrix();
+                    transformMatrix.translate(delta.x(), delta.y());
+                    (*nodeIterator)->textNode()->setMatrix(transformMatrix);
+                    ++nodeIterator;
+                }
 
-        Q_ASSERT(nodeIterator == d->textNodeMap.end() || (*nodeIterator) == firstCleanNode);
-        // Update the position of the subsequent text blocks.
-        if (firstCleanNode) {
-            QPointF oldOffset = firstCleanNode->textNode()->matrix().map(QPointF(0,0));
-            QPointF currentOffset = d->document->documentLayout()->blockBoundingRect(d->document->findBlock(firstCleanNode->startPos())).topLeft();
-            QPointF delta = currentOffset - oldOffset;
-            while (nodeIterator != d->textNodeMap.end()) {
-                QMatrix4x4 transformMatrix = (*nodeIterator)->textNode()->matrix();
-                transformMatrix.translate(delta.x(), delta.y());
-                (*nodeIterator)->textNode()->setMatrix(transformMatrix);
-                ++nodeIterator;
             }
 
-        }
+            // Since we iterate over blocks from different text frames that are potentially not sorted
+            // we need to ensure that our list of nodes is sorted again:
+            std::sort(d->textNodeMap.begin(), d->textNodeMap.end(), &comesBefore);
 
-        // Since we iterate over blocks from different text frames that are potentially not sorted
-        // we need to ensure that our list of nodes is sorted again:
-        std::sort(d->textNodeMap.begin(), d->textNodeMap.end(), &comesBefore);
+            nodeIterator = d->firstDirtyTextNode();
+        } while (nodeIterator != d->textNodeMap.end());
+
+        rootNode->frameDecorationsNode->m_engine->addToSceneGraph(rootNode->frameDecorationsNode, QQuickText::Normal, QColor());
+        // Now prepend the frame decorations since we want them rendered first, with the text nodes and cursor in front.
+        rootNode->prependChildNode(rootNode->frameDecorationsNode);
     }
 
     if (d->cursorComponent == 0 && !isReadOnly()) {
@@ -2177,6 +2221,8 @@ void QQuickTextEdit::updateSize()
         return;
     }
 
+    d->setObservesViewport(d->document->characterCount() > largeTextSizeThreshold);
+
     qreal naturalWidth = d->implicitWidth;
 
     qreal newWidth = d->document->idealWidth();
@@ -2359,14 +2405,139 @@ void QQuickTextEditPrivate::handleFocusEvent(QFocusEvent *event)
     }
 }
 
-void QQuickTextEditPrivate::addCurrentTextNodeToRoot(QSGTransformNode *root, QQuickTextNode *node, TextNodeIterator &it, int startPos)
+void QQuickTextEditPrivate::addCurrentTextNodeToRoot(QSGTransformNode *root, QQuickTextNode *node, TextNodeIterator &it, int startPos, bool culled)
 {
     node->m_engine->addToSceneGraph(node, QQuickText::Normal, QColor());
-    it = textNodeMap.insert(it, new TextNode(startPos, node));
+    TextNode *textNode = new TextNode(startPos, node);
+    textNode->setCulled(culled);
+    it = textNodeMap.insert(it, textNode);
     ++it;
     root->appendChildNode(node);
 }
 
+QQuickTextEditPrivate::TextNodeIterator QQuickTextEditPrivate::firstDirtyTextNode()
+{
+    TextNodeIterator it = textNodeMap.begin();
+    while (it != textNodeMap.end() && !(*it)->dirty())
+        ++it;
+    return it;
+}
+
+/*!
+    Enables culling of text nodes against the visible part of the item.
+
+    While enabled the geometry of every ancestor is observed, so that moving the item within
+    a Flickable or resizing the window regenerates the nodes scrolled into view.
+*/
+void QQuickTextEditPrivate::setObservesViewport(bool observe)
+{
+    Q_Q(QQuickTextEdit);
+    if (observesViewport == observe)
+        return;
+
+    observesViewport = observe;
+    if (observe)
+        watchViewportAncestors();
+    else
+        unwatchViewportAncestors();
+    renderedViewport = QRectF();
+
+    // Regenerate everything against the new culling rectangle.
+    q->updateWholeDocument();
+}
+
+void QQuickTextEditPrivate::watchViewportAncestors()
+{
+    Q_Q(QQuickTextEdit);
+    unwatchViewportAncestors();
+    for (QQuickItem *ancestor = q->parentItem(); ancestor; ancestor = ancestor->parentItem()) {
+        QQuickItemPrivate::get(ancestor)->addItemChangeListener(
+                this, QQuickItemPrivate::Geometry | QQuickItemPrivate::Parent | QQuickItemPrivate::Destroyed);
+        viewportAncestors.append(ancestor);
+    }
+}
+
+void QQuickTextEditPrivate::unwatchViewportAncestors()
+{
+    Q_FOREACH (QQuickItem *ancestor, viewportAncestors) {
+        QQuickItemPrivate::get(ancestor)->removeItemChangeListener(
+                this, QQuickItemPrivate::Geometry | QQuickItemPrivate::Parent | QQuickItemPrivate::Destroyed);
+    }
+    viewportAncestors.clear();
+}
+
+/*!
+    Returns the part of the item, in item coordinates, which is not clipped away by the item,
+    its ancestors or the window.
+*/
+QRectF QQuickTextEditPrivate::viewportRect() const
+{
+    Q_Q(const QQuickTextEdit);
+    QRectF rect = q->boundingRect().united(QRectF(QPointF(xoff, yoff), contentSize));
+
+    for (const QQuickItem *item = q; item; item = item->parentItem()) {
+        if (item->clip())
+            rect &= q->mapRectFromItem(const_cast<QQuickItem *>(item), item->clipRect());
+    }
+    if (window)
+        rect &= q->mapRectFromScene(QRectF(QPointF(0, 0), window->size()));
+
+    return rect;
+}
+
+/*!
+    Returns the rectangle blocks are culled against, the viewport extended by its height in
+    both directions so that short scrolls don't require any nodes to be regenerated.
+*/
+QRectF QQuickTextEditPrivate::viewportCullRect() const
+{
+    const QRectF viewport = viewportRect();
+    if (viewport.isEmpty())
+        return QRectF();
+    return viewport.adjusted(0, -viewport.height(), 0, viewport.height());
+}
+
+void QQuickTextEditPrivate::updateViewport()
+{
+    Q_Q(QQuickTextEdit);
+    if (!observesViewport || textNodeMap.isEmpty() || !q->isComponentComplete())
+        return;
+
+    const QRectF viewport = viewportRect();
+    if (viewport.isEmpty()
+            || (viewport.top() >= renderedViewport.top() && viewport.bottom() <= renderedViewport.bottom())) {
+        return;
+    }
+
+    bool culledNodes = false;
+    Q_FOREACH (Node *node, textNodeMap) {
+        if (node->culled()) {
+            node->setDirty();
+            culledNodes = true;
+        }
+    }
+    if (culledNodes) {
+        updateType = UpdatePaintNode;
+        q->update();
+    }
+}
+
+void QQuickTextEditPrivate::itemGeometryChanged(QQuickItem *, const QRectF &, const QRectF &)
+{
+    updateViewport();
+}
+
+void QQuickTextEditPrivate::itemParentChanged(QQuickItem *, QQuickItem *)
+{
+    watchViewportAncestors();
+    updateViewport();
+}
+
+void QQuickTextEditPrivate::itemDestroyed(QQuickItem *item)
+{
+    viewportAncestors.removeOne(item);
+}
+
 QQuickTextNode *QQuickTextEditPrivate::createTextNode()
 {
     Q_Q(QQuickTextEdit);
@@ -106,6 +106,7 @@ class Q_QUICK_PRIVATE_EXPORT QQuickTextEdit : public QQuickImplicitSizeItem
 
 public:
     QQuickTextEdit(QQuickItem *parent=0);
+    ~QQuickTextEdit();
 
     enum HAlignment {
         AlignLeft = Qt::AlignLeft,
@@ -336,6 +337,7 @@ private:
 protected:
     virtual void geometryChanged(const QRectF &newGeometry,
                                  const QRectF &oldGeometry);
+    void itemChange(ItemChange change, const ItemChangeData &value);
 
     bool event(QEvent *);
     void keyPressEvent(QKeyEvent *);
@@ -56,6 +56,7 @@
 #include "qquicktextedit_p.h"
 #include "qquickimplicitsizeitem_p_p.h"
 #include "qquicktextcontrol_p.h"
+#include "qquickitemchangelistener_p.h"
 
 #include <QtQml/qqml.h>
 #include <QtCore/qlist.h>
@@ -66,7 +67,7 @@ class QQuickTextDocumentWithImageResources;
 class QQuickTextControl;
 class QQuickTextNode;
 class QSGSimpleRectNode;
-class QQuickTextEditPrivate : public QQuickImplicitSizeItemPrivate
+class QQuickTextEditPrivate : public QQuickImplicitSizeItemPrivate, public QQuickItemChangeListener
 {
 public:
     Q_DECLARE_PUBLIC(QQuickTextEdit)
@@ -75,17 +76,20 @@ public:
 
     struct Node {
         explicit Node(int startPos, QQuickTextNode* node)
-            : m_startPos(startPos), m_node(node), m_dirty(false) { }
+            : m_startPos(startPos), m_node(node), m_dirty(false), m_culled(false) { }
         QQuickTextNode* textNode() const { return m_node; }
         void moveStartPos(int delta) { Q_ASSERT(m_startPos + delta > 0); m_startPos += delta; }
         int startPos() const { return m_startPos; }
         void setDirty() { m_dirty = true; }
         bool dirty() const { return m_dirty; }
+        void setCulled(bool culled) { m_culled = culled; }
+        bool culled() const { return m_culled; }
 
     private:
         int m_startPos;
         QQuickTextNode* m_node;
         bool m_dirty;
+        bool m_culled;
     };
     typedef QList<Node*>::iterator TextNodeIterator;
 
@@ -107,7 +111,7 @@ public:
         , focusOnPress(true), persistentSelection(false), requireImplicitWidth(false)
         , selectByMouse(false), canPaste(false), canPasteValid(false), hAlignImplicit(true)
         , textCached(true), inLayout(false), selectByKeyboard(false), selectByKeyboardSet(false)
-        , hadSelection(false)
+        , hadSelection(false), observesViewport(false)
     {
     }
 
@@ -127,8 +131,20 @@ public:
 
     void setNativeCursorEnabled(bool enabled) { control->setCursorWidth(enabled ? 1 : 0); }
     void handleFocusEvent(QFocusEvent *event);
-    void addCurrentTextNodeToRoot(QSGTransformNode *, QQuickTextNode*, TextNodeIterator&, int startPos);
+    void addCurrentTextNodeToRoot(QSGTransformNode *, QQuickTextNode*, TextNodeIterator&, int startPos, bool culled = false);
     QQuickTextNode* createTextNode();
+    TextNodeIterator firstDirtyTextNode();
+
+    void setObservesViewport(bool observe);
+    void watchViewportAncestors();
+    void unwatchViewportAncestors();
+    QRectF viewportRect() const;
+    QRectF viewportCullRect() const;
+    void updateViewport();
+
+    void itemGeometryChanged(QQuickItem *, const QRectF &, const QRectF &);
+    void itemParentChanged(QQuickItem *, QQuickItem *);
+    void itemDestroyed(QQuickItem *item);
 
 #ifndef QT_NO_IM
     Qt::InputMethodHints effectiveInputMethodHints() const;
@@ -155,6 +171,8 @@ public:
     QQuickTextControl *control;
     QQuickTextDocument *quickDocument;
     QList<Node*> textNodeMap;
+    QList<QQuickItem *> viewportAncestors;
+    QRectF renderedViewport;
 
     int lastSelectionStart;
     int lastSelectionEnd;
@@ -194,6 +212,7 @@ public:
     bool selectByKeyboard:1;
     bool selectByKeyboardSet:1;
     bool hadSelection : 1;
+    bool observesViewport : 1;
 };
 
 QT_END_NAMESPACE
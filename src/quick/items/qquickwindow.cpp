@@ -45,6 +45,7 @@
 #include "qquickitem.h"
 #include "qquickitem_p.h"
 #include "qquickevents_p_p.h"
+#include "qquickflickable_p_p.h"
 
 #include <private/qquickdrag_p.h>
 
@@ -273,6 +274,9 @@ void QQuickWindowPrivate::polishItems()
     if (maxPolishCycles == 0)
         qWarning("QQuickWindow: possible QQuickItem::polish() loop");
 
+    for (int ii = 0; ii < cullingFlickables.count(); ++ii)
+        QQuickFlickablePrivate::get(cullingFlickables.at(ii))->cullContent();
+
     updateFocusItemTransform();
 }
 
@@ -375,6 +379,12 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
 
     context->renderNextFrame(renderer, fboId);
     emit q->afterRendering();
+
+    // Textures which did not fit into this frame's upload budget are
+    // uploaded in the next one, and the nodes of those which were uploaded
+    // may stop blending them.
+    if (context->needsFrameAfterTextureUploads())
+        q->update();
 }
 
 QQuickWindowPrivate::QQuickWindowPrivate()
@@ -390,6 +400,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , touchMouseId(-1)
     , touchMousePressTimestamp(0)
     , dirtyItemList(0)
+    , hiddenAncestorPass(0)
     , context(0)
     , renderer(0)
     , windowManager(0)
@@ -2451,6 +2462,14 @@ void QQuickWindowPrivate::updateDirtyNodes()
 
     cleanupNodes();
 
+    // Items are not hidden or shown while the nodes are updated, so which of them are hidden
+    // only needs to be looked up once per update. Windows may be synchronized on different
+    // render threads, each update takes a number of its own.
+    static QBasicAtomicInt nextHiddenAncestorPass = Q_BASIC_ATOMIC_INITIALIZER(0);
+    do {
+        hiddenAncestorPass = quint32(nextHiddenAncestorPass.fetchAndAddRelaxed(1) + 1);
+    } while (hiddenAncestorPass == 0);
+
     QQuickItem *updateList = dirtyItemList;
     dirtyItemList = 0;
     if (updateList) QQuickItemPrivate::get(updateList)->prevDirtyItem = &updateList;
@@ -2636,7 +2655,14 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
 
     if (dirty & QQuickItemPrivate::ContentUpdateMask) {
 
-        if (itemPriv->flags & QQuickItem::ItemHasContents) {
+        QQuickItemPrivate *hiddenPriv = (itemPriv->flags & QQuickItem::ItemHasContents)
+                ? itemPriv->hiddenAncestor(hiddenAncestorPass) : 0;
+        if (hiddenPriv) {
+            // The item is not rendered, so postpone the update of its paint node until it is
+            // shown again. The dirty bits are kept, but the item is off the dirty list.
+            itemPriv->dirtyAttributes |= dirty & QQuickItemPrivate::ContentUpdateMask;
+            hiddenPriv->hasDeferredContent = true;
+        } else if (itemPriv->flags & QQuickItem::ItemHasContents) {
             updatePaintNodeData.transformNode = itemPriv->itemNode();
             itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData);
 
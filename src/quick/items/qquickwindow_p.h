@@ -74,6 +74,7 @@ QT_BEGIN_NAMESPACE
 class QQuickAnimatorController;
 class QSGRenderLoop;
 class QQuickDragGrabber;
+class QQuickFlickable;
 
 class QQuickRootItem : public QQuickItem
 {
@@ -188,6 +189,8 @@ public:
     QList<QSGNode *> cleanupNodeList;
 
     QSet<QQuickItem *> itemsToPolish;
+    QList<QQuickFlickable *> cullingFlickables;
+    quint32 hiddenAncestorPass;
 
     void updateDirtyNodes();
     void cleanupNodes();
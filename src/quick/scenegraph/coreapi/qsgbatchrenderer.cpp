@@ -43,7 +43,12 @@
 #include "qsgbatchrenderer_p.h"
 #include <private/qsgshadersourcebuilder_p.h>
 
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgvertexcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
 
 #include <QtGui/QGuiApplication>
 #include <QtGui/QOpenGLFramebufferObject>
@@ -51,6 +56,7 @@
 
 #include <private/qqmlprofilerservice_p.h>
 #include <private/qsystrace_p.h>
+#include <private/qsimd_p.h>
 
 #include <algorithm>
 
@@ -118,6 +124,7 @@ struct QMatrix4x4_Accessor
     static bool isTranslate(const QMatrix4x4 &m) { return ((const QMatrix4x4_Accessor &) m).flagBits <= 0x1; }
     static bool isScale(const QMatrix4x4 &m) { return ((const QMatrix4x4_Accessor &) m).flagBits <= 0x2; }
     static bool is2DSafe(const QMatrix4x4 &m) { return ((const QMatrix4x4_Accessor &) m).flagBits < 0x8; }
+    static bool isAxisAligned(const QMatrix4x4 &m) { return ((const QMatrix4x4_Accessor &) m).flagBits <= 0x3; }
 };
 
 const float OPAQUE_LIMIT                = 0.999f;
@@ -771,6 +778,9 @@ Renderer::Renderer(QSGRenderContext *ctx)
     , m_currentShader(0)
     , m_currentClip(0)
     , m_currentClipType(NoClip)
+    , m_occlusionElements(64)
+    , m_uploadBatches(16)
+    , m_uploadPool(0)
     , m_vao(0)
 {
     setNodeUpdater(new Updater(this));
@@ -791,6 +801,31 @@ Renderer::Renderer(QSGRenderContext *ctx)
         m_bufferStrategy = GL_STREAM_DRAW;
     }
 
+    // Batches which are re-uploaded with an unchanged size only upload the
+    // ranges which actually changed, unless disabled.
+    m_partialUploads = qgetenv("QSG_RENDERER_PARTIAL_UPLOADS") != "0";
+    m_uploadedBytes = 0;
+    m_uploadedBuffers = 0;
+    m_partiallyUploadedBuffers = 0;
+
+    // Merging vertex data into batches is spread over a few threads once
+    // there is enough of it.
+    m_uploadThreadCount = qMin(QThread::idealThreadCount(), 4);
+    QByteArray uploadThreads = qgetenv("QSG_RENDERER_UPLOAD_THREADS");
+    if (uploadThreads.length() > 0) {
+        bool ok = false;
+        int threads = uploadThreads.toInt(&ok);
+        if (ok)
+            m_uploadThreadCount = threads;
+    }
+    m_parallelUploadThreshold = 8192;
+
+    // Opaque elements which are completely covered by opaque rectangles in
+    // front of them are left out of uploads and draw calls, if enabled.
+    m_occlusionCulling = qgetenv("QSG_RENDERER_OCCLUSION_CULLING").toInt() != 0;
+    m_occlusionDirty = false;
+    m_occludedElements = 0;
+
     m_batchNodeThreshold = 64;
     QByteArray alternateThreshold = qgetenv("QSG_RENDERER_BATCH_NODE_THRESHOLD");
     if (alternateThreshold.length() > 0) {
@@ -810,7 +845,8 @@ Renderer::Renderer(QSGRenderContext *ctx)
     }
     if (Q_UNLIKELY(debug_build || debug_render)) {
         qDebug() << "Batch thresholds: nodes:" << m_batchNodeThreshold << " vertices:" << m_batchVertexThreshold;
-        qDebug() << "Using buffer strategy:" << (m_bufferStrategy == GL_STATIC_DRAW ? "static" : (m_bufferStrategy == GL_DYNAMIC_DRAW ? "dynamic" : "stream"));
+        qDebug() << "Using buffer strategy:" << (m_bufferStrategy == GL_STATIC_DRAW ? "static" : (m_bufferStrategy == GL_DYNAMIC_DRAW ? "dynamic" : "stream"))
+                 << (m_partialUploads ? "with partial uploads" : "");
     }
 
     // If rendering with an OpenGL Core profile context, we need to create a VAO
@@ -840,6 +876,8 @@ static void qsg_wipeBatch(Batch *batch, QOpenGLFunctions *funcs)
 
 Renderer::~Renderer()
 {
+    delete m_uploadPool;
+
     // Clean up batches and buffers
     for (int i=0; i<m_opaqueBatches.size(); ++i) qsg_wipeBatch(m_opaqueBatches.at(i), this);
     for (int i=0; i<m_alphaBatches.size(); ++i) qsg_wipeBatch(m_alphaBatches.at(i), this);
@@ -894,6 +932,65 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
     GLenum target = isIndexBuf ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
     glBindBuffer(target, buffer->id);
     glBufferData(target, buffer->size, buffer->data, m_bufferStrategy);
+
+    m_uploadedBytes += buffer->size;
+    ++m_uploadedBuffers;
+}
+
+/* Batches are typically re-uploaded because a few of their elements changed
+ * geometry or moved relative to the batch root, while the layout of the batch
+ * is the same as last frame. In that case, we compare the new content against
+ * 'previous', the content of the last upload, and only send the ranges which
+ * differ using glBufferSubData.
+ *
+ * When most of the buffer has changed, or the changes are spread all over it,
+ * we respecify the whole buffer instead, which lets the driver orphan the old
+ * storage rather than synchronize with draw calls still using it.
+ */
+void Renderer::unmapChanges(Buffer *buffer, const char *previous, bool isIndexBuf)
+{
+    Q_ASSERT(buffer->id);
+
+    const int blockSize = 256;
+    const int maxRanges = 8;
+    int ranges[maxRanges][2];
+    int rangeCount = 0;
+    int changedBytes = 0;
+
+    for (int offset = 0; offset < buffer->size; offset += blockSize) {
+        int length = qMin(blockSize, buffer->size - offset);
+        if (memcmp(buffer->data + offset, previous + offset, length) == 0)
+            continue;
+        if (rangeCount > 0 && (ranges[rangeCount - 1][1] == offset || rangeCount == maxRanges)) {
+            // Extend the last range, which also covers any unchanged gap in between
+            changedBytes += offset + length - ranges[rangeCount - 1][1];
+            ranges[rangeCount - 1][1] = offset + length;
+        } else {
+            ranges[rangeCount][0] = offset;
+            ranges[rangeCount][1] = offset + length;
+            changedBytes += length;
+            ++rangeCount;
+        }
+    }
+
+    if (rangeCount == 0)
+        return;
+
+    if (changedBytes * 2 > buffer->size) {
+        unmap(buffer, isIndexBuf);
+        return;
+    }
+
+    GLenum target = isIndexBuf ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    glBindBuffer(target, buffer->id);
+    for (int i=0; i<rangeCount; ++i)
+        glBufferSubData(target, ranges[i][0], ranges[i][1] - ranges[i][0], buffer->data + ranges[i][0]);
+
+    if (Q_UNLIKELY(debug_upload)) qDebug() << "  --- partial upload:" << changedBytes << "of" << buffer->size << "bytes in" << rangeCount << "ranges";
+
+    m_uploadedBytes += changedBytes;
+    ++m_uploadedBuffers;
+    ++m_partiallyUploadedBuffers;
 }
 
 BatchRootInfo *Renderer::batchRootInfo(Node *node)
@@ -976,8 +1073,12 @@ void Renderer::nodeWasTransformed(Node *node, int *vertexCount)
             if (e->batch) {
                 if (!e->batch->isOpaque) {
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
-                } else if (e->batch->merged) {
-                    e->batch->needsUpload = true;
+                } else {
+                    if (e->batch->merged)
+                        e->batch->needsUpload = true;
+                    // Unmerged batches are not uploaded again when their
+                    // elements move, so occlusion has to be told directly.
+                    m_occlusionDirty = true;
                 }
             }
         }
@@ -1509,28 +1610,303 @@ void Renderer::prepareOpaqueBatches()
     }
 }
 
-bool Renderer::checkOverlap(int first, int last, const Rect &bounds)
+/*
+    Returns true if the geometry covers every point of its bounding rect. This
+    is the case for triangle strips which form a ladder of rungs spanning the
+    full width (or height) of the bounds, like the ones built for rectangles
+    and images.
+ */
+bool OcclusionBuffer::fillsBounds(QSGGeometry *g)
 {
-    for (int i=first; i<=last; ++i) {
-        Element *e = m_alphaRenderList.at(i);
-        if (!e || e->batch)
-            continue;
-        Q_ASSERT(e->boundsComputed);
-        if (e->bounds.intersects(bounds))
+    if (g->drawingMode() != GL_TRIANGLE_STRIP)
+        return false;
+
+    const int offset = qsg_positionAttribute(g);
+    const int count = g->indexCount() ? g->indexCount() : g->vertexCount();
+    if (offset < 0 || count < 4 || count % 2 || count > MaxOccluderVertices)
+        return false;
+    if (g->indexCount() && g->indexType() != GL_UNSIGNED_SHORT)
+        return false;
+
+    const char *vertexData = static_cast<const char *>(g->vertexData()) + offset;
+    const quint16 *indices = g->indexCount() ? g->indexDataAsUShort() : 0;
+    const int vertexCount = g->vertexCount();
+    const int stride = g->sizeOfVertex();
+
+    Pt p[MaxOccluderVertices];
+    Rect r;
+    r.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i=0; i<count; ++i) {
+        int v = indices ? indices[i] : i;
+        if (v >= vertexCount)
+            return false;
+        p[i] = *(const Pt *) (vertexData + v * stride);
+        r |= p[i];
+    }
+    if (!(r.tl.x < r.br.x && r.tl.y < r.br.y))
+        return false;
+
+    // Rungs are either horizontal or vertical, and always start on the same side
+    const bool horizontal = p[0].y == p[1].y;
+    float previous = horizontal ? r.tl.y : r.tl.x;
+    for (int i=0; i<count; i += 2) {
+        const Pt &a = p[i];
+        const Pt &b = p[i + 1];
+        float along = horizontal ? a.y : a.x;
+        if (horizontal) {
+            if (a.y != b.y || a.x != p[0].x || b.x != p[1].x)
+                return false;
+        } else {
+            if (a.x != b.x || a.y != p[0].y || b.y != p[1].y)
+                return false;
+        }
+        if (along < previous)
+            return false;
+        previous = along;
+    }
+
+    if (horizontal) {
+        return qMin(p[0].x, p[1].x) == r.tl.x && qMax(p[0].x, p[1].x) == r.br.x
+                && p[0].y == r.tl.y && p[count - 1].y == r.br.y;
+    }
+    return qMin(p[0].y, p[1].y) == r.tl.y && qMax(p[0].y, p[1].y) == r.br.y
+            && p[0].x == r.tl.x && p[count - 1].x == r.br.x;
+}
+
+/*
+    Returns true if the material draws every fragment of its geometry where
+    the geometry is. Only the built in materials of rectangles and images are
+    known to do so; other materials, like those of shader effects, may move
+    vertices in the vertex shader or discard fragments.
+ */
+bool OcclusionBuffer::isOpaqueMaterial(QSGMaterial *m)
+{
+    static QSGMaterialType *flatColorType = QSGFlatColorMaterial().type();
+    static QSGMaterialType *vertexColorType = QSGVertexColorMaterial().type();
+    static QSGMaterialType *opaqueTextureType = QSGOpaqueTextureMaterial().type();
+    static QSGMaterialType *textureType = QSGTextureMaterial().type();
+
+    QSGMaterialType *type = m->type();
+    if (type == flatColorType || type == vertexColorType)
+        return true;
+    if (type == opaqueTextureType || type == textureType) {
+        QSGTexture *t = static_cast<QSGOpaqueTextureMaterial *>(m)->texture();
+        return t && !t->hasAlphaChannel();
+    }
+    return false;
+}
+
+void OcclusionBuffer::add(const Rect &r, const Node *root, const QSGClipNode *clip)
+{
+    const float area = (r.br.x - r.tl.x) * (r.br.y - r.tl.y);
+
+    // When full, replace the smallest occluder if the new one is larger
+    int index = m_count;
+    if (m_count == MaxOccluders) {
+        index = 0;
+        for (int i=1; i<m_count; ++i) {
+            if (m_occluders[i].area < m_occluders[index].area)
+                index = i;
+        }
+        if (m_occluders[index].area >= area)
+            return;
+    } else {
+        ++m_count;
+    }
+
+    Occluder &o = m_occluders[index];
+    o.rect = r;
+    o.area = area;
+    o.root = root;
+    o.clip = clip;
+}
+
+bool OcclusionBuffer::isOccluded(const Rect &r, const Node *root, const QSGClipNode *clip) const
+{
+    for (int i=0; i<m_count; ++i) {
+        const Occluder &o = m_occluders[i];
+        if (o.root == root && o.clip == clip && o.rect.contains(r))
+            return true;
+    }
+    return false;
+}
+
+/* Marks the opaque elements which are completely covered by opaque
+ * rectangles and images in front of them. Merged batches leave these elements out when
+ * they are uploaded and unmerged batches skip their draw calls. This only
+ * needs to happen when the render lists, the geometry of opaque batches or
+ * the transforms of opaque elements changed, as batch root transforms move
+ * occluders and occluded elements together.
+ */
+void Renderer::cullOccludedElements()
+{
+    bool changed = m_rebuild != 0 || m_occlusionDirty;
+    for (int i=0; i<m_opaqueBatches.size() && !changed; ++i)
+        changed = m_opaqueBatches.at(i)->needsUpload;
+    if (!changed)
+        return;
+    m_occlusionDirty = false;
+
+    // The opaque render list is not always sorted, so do it here, front to back
+    m_occlusionElements.reset();
+    for (int i=0; i<m_opaqueRenderList.size(); ++i) {
+        Element *e = m_opaqueRenderList.at(i);
+        if (e && !e->removed && e->batch)
+            m_occlusionElements.add(e);
+    }
+    if (m_occlusionElements.size())
+        std::sort(&m_occlusionElements.first(), &m_occlusionElements.last() + 1, qsg_sort_element_decreasing_order);
+
+    m_occluders.clear();
+    m_occludedElements = 0;
+    for (int i=0; i<m_occlusionElements.size(); ++i) {
+        Element *e = m_occlusionElements.at(i);
+        e->ensureBoundsValid();
+
+        QSGGeometryNode *gn = e->node;
+        bool occluded = !e->boundsOutsideFloatRange
+                && m_occluders.isOccluded(e->bounds, e->root, gn->clipList());
+
+        if (occluded != bool(e->occluded)) {
+            e->occluded = occluded;
+            if (e->batch->merged)
+                e->batch->needsUpload = true;
+        }
+
+        if (occluded) {
+            ++m_occludedElements;
+        } else if (!e->boundsOutsideFloatRange
+                   && QMatrix4x4_Accessor::isAxisAligned(*gn->matrix())
+                   && OcclusionBuffer::isOpaqueMaterial(gn->activeMaterial())
+                   && OcclusionBuffer::fillsBounds(gn->geometry())) {
+            m_occluders.add(e->bounds, e->root, gn->clipList());
+        }
+    }
+}
+
+OverlapIndex::OverlapIndex()
+    : m_rects(64)
+    , m_largeRects(16)
+    , m_entries(256)
+    , m_hasGrid(false)
+{
+    m_bounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+void OverlapIndex::clear()
+{
+    m_bounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    m_rects.reset();
+    if (m_hasGrid) {
+        m_largeRects.reset();
+        m_entries.reset();
+        m_hasGrid = false;
+    }
+}
+
+void OverlapIndex::add(const Rect &r)
+{
+    m_bounds |= r;
+    m_rects.add(r);
+    if (m_hasGrid)
+        addToGrid(m_rects.size() - 1);
+    else if (m_rects.size() > LinearLimit)
+        buildGrid();
+}
+
+bool OverlapIndex::intersects(const Rect &r) const
+{
+    // The union of all rects rejects most queries in the typical list case.
+    if (!m_bounds.intersects(r))
+        return false;
+
+    int x0, y0, x1, y1;
+    if (m_hasGrid)
+        cellRange(r, &x0, &y0, &x1, &y1);
+
+    if (!m_hasGrid || (x1 - x0 + 1) * (y1 - y0 + 1) > m_rects.size()) {
+        for (int i = 0; i < m_rects.size(); ++i) {
+            if (m_rects.at(i).intersects(r))
+                return true;
+        }
+        return false;
+    }
+
+    for (int i = 0; i < m_largeRects.size(); ++i) {
+        if (m_rects.at(m_largeRects.at(i)).intersects(r))
             return true;
     }
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            for (int e = m_cells[y * GridSize + x]; e >= 0; e = m_entries.at(e).next) {
+                if (m_rects.at(m_entries.at(e).rect).intersects(r))
+                    return true;
+            }
+        }
+    }
     return false;
 }
 
+void OverlapIndex::buildGrid()
+{
+    const float w = m_bounds.br.x - m_bounds.tl.x;
+    const float h = m_bounds.br.y - m_bounds.tl.y;
+    m_origin = m_bounds.tl;
+    m_scale.set(w > 0 ? GridSize / w : 0, h > 0 ? GridSize / h : 0);
+    memset(m_cells, -1, sizeof(m_cells));
+    m_hasGrid = true;
+
+    for (int i = 0; i < m_rects.size(); ++i)
+        addToGrid(i);
+}
+
+void OverlapIndex::addToGrid(int index)
+{
+    int x0, y0, x1, y1;
+    cellRange(m_rects.at(index), &x0, &y0, &x1, &y1);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > LargeCellCount) {
+        m_largeRects.add(index);
+        return;
+    }
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            Entry entry = { index, m_cells[y * GridSize + x] };
+            m_cells[y * GridSize + x] = m_entries.size();
+            m_entries.add(entry);
+        }
+    }
+}
+
+static inline int qsg_overlapCell(float v, float origin, float scale)
+{
+    // Monotonic in v, so that rects which intersect always share a cell.
+    const float c = (v - origin) * scale;
+    if (!(c > 0))
+        return 0;
+    if (c >= OverlapIndex::GridSize)
+        return OverlapIndex::GridSize - 1;
+    return int(c);
+}
+
+void OverlapIndex::cellRange(const Rect &r, int *x0, int *y0, int *x1, int *y1) const
+{
+    *x0 = qsg_overlapCell(r.tl.x, m_origin.x, m_scale.x);
+    *y0 = qsg_overlapCell(r.tl.y, m_origin.y, m_scale.y);
+    *x1 = qsg_overlapCell(r.br.x, m_origin.x, m_scale.x);
+    *y1 = qsg_overlapCell(r.br.y, m_origin.y, m_scale.y);
+}
+
 /*
  *
- * To avoid the O(n^2) checkOverlap check in most cases, we have the
- * overlapBounds which is the union of all bounding rects to check overlap
- * for. We know that if it does not overlap, then none of the individual
- * ones will either. For the typical list case, this results in no calls
- * to checkOverlap what-so-ever. This also ensures that when all consecutive
- * items are matching (such as a table of text), we don't build up an
- * overlap bounds and thus do not require full overlap checks.
+ * Compatible elements can only be merged into a batch if they do not overlap
+ * any of the incompatible elements between them and the start of the batch,
+ * as those are rendered in between. The incompatible elements are collected
+ * in m_alphaOverlaps, which first checks their union and then a grid of the
+ * individual bounds. For the typical list case the union never intersects.
+ * This also ensures that when all consecutive items are matching (such as a
+ * table of text), we don't build up any overlap bounds at all.
  */
 
 void Renderer::prepareAlphaBatches()
@@ -1570,8 +1946,7 @@ void Renderer::prepareAlphaBatches()
         QSGGeometryNode *gni = ei->node;
         batch->positionAttribute = qsg_positionAttribute(gni->geometry());
 
-        Rect overlapBounds;
-        overlapBounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        m_alphaOverlaps.clear();
 
         Element *next = ei;
 
@@ -1592,7 +1967,7 @@ void Renderer::prepareAlphaBatches()
                     && gni->inheritedOpacity() == gnj->inheritedOpacity()
                     && gni->activeMaterial()->type() == gnj->activeMaterial()->type()
                     && gni->activeMaterial()->compare(gnj->activeMaterial()) == 0) {
-                if (!overlapBounds.intersects(ej->bounds) || !checkOverlap(i+1, j - 1, ej->bounds)) {
+                if (!m_alphaOverlaps.intersects(ej->bounds)) {
                     ej->batch = batch;
                     next->nextInBatch = ej;
                     next = ej;
@@ -1605,7 +1980,7 @@ void Renderer::prepareAlphaBatches()
                     break;
                 }
             } else {
-                overlapBounds |= ej->bounds;
+                m_alphaOverlaps.add(ej->bounds);
             }
         }
 
@@ -1615,6 +1990,93 @@ void Renderer::prepareAlphaBatches()
 
 }
 
+void translateVertices(char *vertices, int count, int stride, float dx, float dy)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    // two vertices per iteration
+    const __m128 d = _mm_setr_ps(dx, dy, dx, dy);
+    for (; i < count - 1; i += 2) {
+        __m64 *p0 = (__m64 *) vertices;
+        __m64 *p1 = (__m64 *) (vertices + stride);
+        __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p0), p1);
+        v = _mm_add_ps(v, d);
+        _mm_storel_pi(p0, v);
+        _mm_storeh_pi(p1, v);
+        vertices += 2 * stride;
+    }
+#elif defined(__ARM_NEON__)
+    const float delta[2] = { dx, dy };
+    const float32x2_t d = vld1_f32(delta);
+    for (; i < count; ++i) {
+        float *p = (float *) vertices;
+        vst1_f32(p, vadd_f32(vld1_f32(p), d));
+        vertices += stride;
+    }
+#endif
+    for (; i < count; ++i) {
+        Pt *p = (Pt *) vertices;
+        p->x += dx;
+        p->y += dy;
+        vertices += stride;
+    }
+}
+
+void transformVertices(char *vertices, int count, int stride, const QMatrix4x4 &matrix)
+{
+    int i = 0;
+    // The operations are done in the same order as in Pt::map(), so that the
+    // results are identical to the scalar code.
+#if defined(__SSE2__)
+    const float *m = matrix.constData();
+    const __m128 m0 = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 m4 = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 m12 = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    for (; i < count - 1; i += 2) {
+        __m64 *p0 = (__m64 *) vertices;
+        __m64 *p1 = (__m64 *) (vertices + stride);
+        const __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p0), p1);
+        const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), m12);
+        _mm_storel_pi(p0, r);
+        _mm_storeh_pi(p1, r);
+        vertices += 2 * stride;
+    }
+#elif defined(__ARM_NEON__)
+    const float *m = matrix.constData();
+    const float32x2_t m0 = vld1_f32(m);
+    const float32x2_t m4 = vld1_f32(m + 4);
+    const float32x2_t m12 = vld1_f32(m + 12);
+    for (; i < count; ++i) {
+        float *p = (float *) vertices;
+        const float32x2_t v = vld1_f32(p);
+        vst1_f32(p, vadd_f32(vadd_f32(vmul_lane_f32(m0, v, 0), vmul_lane_f32(m4, v, 1)), m12));
+        vertices += stride;
+    }
+#endif
+    for (; i < count; ++i) {
+        ((Pt *) vertices)->map(matrix);
+        vertices += stride;
+    }
+}
+
+void fillZOrder(float *zData, int count, float zorder)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 z = _mm_set1_ps(zorder);
+    for (; i < count - 3; i += 4)
+        _mm_storeu_ps(zData + i, z);
+#elif defined(__ARM_NEON__)
+    const float32x4_t z = vdupq_n_f32(zorder);
+    for (; i < count - 3; i += 4)
+        vst1q_f32(zData + i, z);
+#endif
+    for (; i < count; ++i)
+        zData[i] = zorder;
+}
+
 /* These parameters warrant some explanation...
  *
  * vaOffset: The byte offset into the vertex data to the location of the
@@ -1643,24 +2105,15 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     // apply vertex transform..
     char *vdata = *vertexData + vaOffset;
     if (((const QMatrix4x4_Accessor &) localx).flagBits == 1) {
-        for (int i=0; i<vCount; ++i) {
-            Pt *p = (Pt *) vdata;
-            p->x += ((QMatrix4x4_Accessor &) localx).m[3][0];
-            p->y += ((QMatrix4x4_Accessor &) localx).m[3][1];
-            vdata += vSize;
-        }
+        translateVertices(vdata, vCount, vSize,
+                          ((QMatrix4x4_Accessor &) localx).m[3][0],
+                          ((QMatrix4x4_Accessor &) localx).m[3][1]);
     } else if (((const QMatrix4x4_Accessor &) localx).flagBits > 1) {
-        for (int i=0; i<vCount; ++i) {
-            ((Pt *) vdata)->map(localx);
-            vdata += vSize;
-        }
+        transformVertices(vdata, vCount, vSize, localx);
     }
 
     if (m_useDepthBuffer) {
-        float *vzorder = (float *) *zData;
-        float zorder = 1.0f - e->order * m_zRange;
-        for (int i=0; i<vCount; ++i)
-            vzorder[i] = zorder;
+        fillZOrder((float *) *zData, vCount, 1.0f - e->order * m_zRange);
         *zData += vCount * sizeof(float);
     }
 
@@ -1700,22 +2153,31 @@ const QMatrix4x4 &Renderer::matrixForRoot(Node *node)
     return *c->matrix();
 }
 
-void Renderer::uploadBatch(Batch *b)
+/* Uploading a batch happens in three steps. prepareBatchUpload() figures out
+ * the layout of the batch and allocates its CPU-side buffers, fillBatch()
+ * merges the vertex and index data of all its elements into them and
+ * finishBatchUpload() sends the result to the GPU.
+ *
+ * Batches only ever write into their own buffers and only read from the
+ * nodes, so fillBatch() can run for several batches in parallel. It must not
+ * touch any GL state or renderer members other than the ones it reads.
+ */
+bool Renderer::prepareBatchUpload(Batch *b, UploadSlot *slot)
 {
         // Early out if nothing has changed in this batch..
         if (!b->needsUpload) {
             if (Q_UNLIKELY(debug_upload)) qDebug() << " Batch:" << b << "already uploaded...";
-            return;
+            return false;
         }
 
         if (!b->first) {
             if (Q_UNLIKELY(debug_upload)) qDebug() << " Batch:" << b << "is invalid...";
-            return;
+            return false;
         }
 
         if (b->isRenderNode) {
             if (Q_UNLIKELY(debug_upload)) qDebug() << " Batch: " << b << "is a render node...";
-            return;
+            return false;
         }
 
         // Figure out if we can merge or not, if not, then just render the batch as is..
@@ -1741,6 +2203,10 @@ void Renderer::uploadBatch(Batch *b)
         Element *e = b->first;
 
         while (e) {
+            if (b->merged && b->isOpaque && e->occluded) {
+                e = e->nextInBatch;
+                continue;
+            }
             QSGGeometry *eg = e->node->geometry();
             b->vertexCount += eg->vertexCount();
             int iCount = eg->indexCount();
@@ -1761,8 +2227,13 @@ void Renderer::uploadBatch(Batch *b)
 
         // Abort if there are no vertices in this batch.. We abort this late as
         // this is a broken usecase which we do not care to optimize for...
-        if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-            return;
+        if (b->vertexCount == 0 || (b->merged && b->indexCount == 0)) {
+            // ... unless all of its elements are occluded, which is fine until
+            // one of them comes back into view
+            if (b->merged && b->isOpaque && b->vertexCount == 0)
+                b->needsUpload = false;
+            return false;
+        }
 
         /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
@@ -1786,13 +2257,32 @@ void Renderer::uploadBatch(Batch *b)
             ibufferSize = unmergedIndexSize;
         }
 
+        // If the buffers keep their size, remember what was uploaded last time so
+        // that only the changed ranges need to be sent to the GPU.
 #ifdef QSG_SEPARATE_INDEX_BUFFER
+        slot->partialIndexUpload = m_partialUploads && b->ibo.id && b->ibo.size == ibufferSize;
+        if (slot->partialIndexUpload) {
+            slot->previousIndexData.resize(ibufferSize);
+            memcpy(slot->previousIndexData.data(), b->ibo.data, ibufferSize);
+        }
         map(&b->ibo, ibufferSize);
 #else
         bufferSize += ibufferSize;
 #endif
+        slot->partialUpload = m_partialUploads && b->vbo.id && b->vbo.size == bufferSize;
+        if (slot->partialUpload) {
+            slot->previousVertexData.resize(bufferSize);
+            memcpy(slot->previousVertexData.data(), b->vbo.data, bufferSize);
+        }
         map(&b->vbo, bufferSize);
 
+        return true;
+}
+
+void Renderer::fillBatch(Batch *b)
+{
+        QSGGeometry *g = b->first->node->geometry();
+
         if (Q_UNLIKELY(debug_upload)) qDebug() << " - batch" << b << " first:" << b->first << " root:"
                                    << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
                                    << " vbo:" << b->vbo.id << ":" << b->vbo.size;
@@ -1807,7 +2297,7 @@ void Renderer::uploadBatch(Batch *b)
 #endif
 
             quint16 iOffset = 0;
-            e = b->first;
+            Element *e = b->first;
             int verticesInSet = 0;
             int indicesInSet = 0;
             b->drawSets.reset();
@@ -1818,6 +2308,10 @@ void Renderer::uploadBatch(Batch *b)
 #endif
             b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
             while (e) {
+                if (b->isOpaque && e->occluded) {
+                    e = e->nextInBatch;
+                    continue;
+                }
                 verticesInSet  += e->node->geometry()->vertexCount();
                 if (verticesInSet > 0xffff) {
                     b->drawSets.last().indexCount = indicesInSet;
@@ -1858,6 +2352,11 @@ void Renderer::uploadBatch(Batch *b)
                 e = e->nextInBatch;
             }
         }
+}
+
+void Renderer::finishBatchUpload(Batch *b, const UploadSlot *slot)
+{
+        QSGGeometry *g = b->first->node->geometry();
 
         if (Q_UNLIKELY(debug_upload)) {
             const char *vd = b->vbo.data;
@@ -1909,9 +2408,15 @@ void Renderer::uploadBatch(Batch *b)
             }
         }
 
-        unmap(&b->vbo);
+        if (slot->partialUpload)
+            unmapChanges(&b->vbo, slot->previousVertexData.constData());
+        else
+            unmap(&b->vbo);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        unmap(&b->ibo, true);
+        if (slot->partialIndexUpload)
+            unmapChanges(&b->ibo, slot->previousIndexData.constData(), true);
+        else
+            unmap(&b->ibo, true);
 #endif
 
         if (Q_UNLIKELY(debug_upload)) qDebug() << "  --- vertex/index buffers unmapped, batch upload completed...";
@@ -1922,6 +2427,73 @@ void Renderer::uploadBatch(Batch *b)
             b->uploadedThisFrame = true;
 }
 
+class BatchFillJob : public QRunnable
+{
+public:
+    BatchFillJob(Renderer *renderer) : m_renderer(renderer) { }
+    void run() Q_DECL_OVERRIDE { m_renderer->fillBatches(); }
+
+private:
+    Renderer *m_renderer;
+};
+
+void Renderer::fillBatches()
+{
+    int i;
+    while ((i = m_nextBatchToFill.fetchAndAddRelaxed(1)) < m_uploadBatches.size())
+        fillBatch(m_uploadBatches.at(i));
+}
+
+/* Uploads all opaque batches followed by all alpha batches. When there is
+ * enough vertex data to merge, filling the buffers is spread over a small
+ * pool of worker threads, with the render thread taking part. The GL calls
+ * are always made from the render thread, in the same order as when filling
+ * serially, so the result is identical either way.
+ */
+void Renderer::uploadBatches()
+{
+    m_uploadBatches.reset();
+    int vertexCount = 0;
+    int batchCount = m_opaqueBatches.size() + m_alphaBatches.size();
+    for (int i=0; i<batchCount; ++i) {
+        if (Q_UNLIKELY(debug_upload)) {
+            if (i == 0)
+                qDebug() << "Uploading Opaque Batches:";
+            if (i == m_opaqueBatches.size())
+                qDebug() << "Uploading Alpha Batches:";
+        }
+        Batch *b = i < m_opaqueBatches.size() ? m_opaqueBatches.at(i) : m_alphaBatches.at(i - m_opaqueBatches.size());
+        if (m_uploadSlots.size() <= m_uploadBatches.size())
+            m_uploadSlots.resize(m_uploadBatches.size() + 1);
+        if (prepareBatchUpload(b, &m_uploadSlots[m_uploadBatches.size()])) {
+            m_uploadBatches.add(b);
+            vertexCount += b->vertexCount;
+        }
+    }
+
+    if (m_uploadThreadCount > 1
+            && m_uploadBatches.size() > 1
+            && vertexCount >= m_parallelUploadThreshold
+            && !debug_upload) {
+        if (!m_uploadPool) {
+            m_uploadPool = new QThreadPool;
+            m_uploadPool->setMaxThreadCount(m_uploadThreadCount - 1);
+        }
+        m_nextBatchToFill.store(0);
+        int jobs = qMin(m_uploadThreadCount, m_uploadBatches.size()) - 1;
+        for (int i=0; i<jobs; ++i)
+            m_uploadPool->start(new BatchFillJob(this));
+        fillBatches();
+        m_uploadPool->waitForDone();
+    } else {
+        for (int i=0; i<m_uploadBatches.size(); ++i)
+            fillBatch(m_uploadBatches.at(i));
+    }
+
+    for (int i=0; i<m_uploadBatches.size(); ++i)
+        finishBatchUpload(m_uploadBatches.at(i), &m_uploadSlots.at(i));
+}
+
 void Renderer::updateClip(const QSGClipNode *clipList, const Batch *batch)
 {
     if (clipList != m_currentClip && Q_LIKELY(!debug_noclip)) {
@@ -2159,6 +2731,14 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
     while (e) {
         gn = e->node;
 
+        if (batch->isOpaque && e->occluded) {
+            QSGGeometry *g = gn->geometry();
+            vOffset += g->sizeOfVertex() * g->vertexCount();
+            iOffset += g->indexCount() * g->sizeOfIndex();
+            e = e->nextInBatch;
+            continue;
+        }
+
         m_current_model_view_matrix = rootMatrix * *gn->matrix();
         m_current_determinant = m_current_model_view_matrix.determinant();
 
@@ -2415,13 +2995,23 @@ void Renderer::render()
     }
 
 
-    if (Q_UNLIKELY(debug_upload)) qDebug() << "Uploading Opaque Batches:";
-    for (int i=0; i<m_opaqueBatches.size(); ++i)
-        uploadBatch(m_opaqueBatches.at(i));
+    if (m_occlusionCulling)
+        cullOccludedElements();
 
-    if (Q_UNLIKELY(debug_upload)) qDebug() << "Uploading Alpha Batches:";
-    for (int i=0; i<m_alphaBatches.size(); ++i)
-        uploadBatch(m_alphaBatches.at(i));
+    m_uploadedBytes = 0;
+    m_uploadedBuffers = 0;
+    m_partiallyUploadedBuffers = 0;
+
+    uploadBatches();
+
+#ifndef QSG_NO_RENDER_TIMING
+    if (qsg_render_timing) {
+        qDebug(" - uploaded %d bytes in %d buffers (%d partial)",
+               m_uploadedBytes, m_uploadedBuffers, m_partiallyUploadedBuffers);
+        if (m_occlusionCulling)
+            qDebug(" - culled %d occluded elements", m_occludedElements);
+    }
+#endif
 
     renderBatches();
 
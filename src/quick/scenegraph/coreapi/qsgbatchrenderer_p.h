@@ -48,6 +48,8 @@
 
 #include <private/qsgrendernode_p.h>
 
+#include <QtCore/QThreadPool>
+
 QT_BEGIN_NAMESPACE
 
 class QOpenGLVertexArrayObject;
@@ -90,6 +92,12 @@ inline QDebug operator << (QDebug d, const Pt &p) {
     return d;
 }
 
+// Vertex kernels used when merging geometry. They operate on the 2D position of
+// count vertices which are stride bytes apart, starting at vertices.
+Q_QUICK_PRIVATE_EXPORT void translateVertices(char *vertices, int count, int stride, float dx, float dy);
+Q_QUICK_PRIVATE_EXPORT void transformVertices(char *vertices, int count, int stride, const QMatrix4x4 &matrix);
+Q_QUICK_PRIVATE_EXPORT void fillZOrder(float *zData, int count, float zorder);
+
 
 
 struct Rect {
@@ -124,12 +132,16 @@ struct Rect {
         br.set(right, bottom);
     }
 
-    bool intersects(const Rect &r) {
+    bool intersects(const Rect &r) const {
         bool xOverlap = r.tl.x < br.x && r.br.x > tl.x;
         bool yOverlap = r.tl.y < br.y && r.br.y > tl.y;
         return xOverlap && yOverlap;
     }
 
+    bool contains(const Rect &r) const {
+        return r.tl.x >= tl.x && r.tl.y >= tl.y && r.br.x <= br.x && r.br.y <= br.y;
+    }
+
     bool isOutsideFloatRange() const {
         return tl.x < -QSG_RENDERER_COORD_LIMIT
                 || tl.y < -QSG_RENDERER_COORD_LIMIT
@@ -143,12 +155,99 @@ inline QDebug operator << (QDebug d, const Rect &r) {
     return d;
 }
 
+/*
+    Answers whether a rect intersects any rect of a growing set. Small sets are
+    searched linearly, larger ones through a uniform grid which spans the bounds
+    of the set at the time it grew large. Rects outside of the grid are clamped
+    to its edge cells.
+ */
+class Q_QUICK_PRIVATE_EXPORT OverlapIndex
+{
+public:
+    OverlapIndex();
+
+    void clear();
+    void add(const Rect &r);
+    bool intersects(const Rect &r) const;
+
+    enum {
+        LinearLimit = 16,
+        GridSize = 32,
+        LargeCellCount = 64
+    };
+
+private:
+    struct Entry {
+        int rect;
+        int next;
+    };
+
+    void buildGrid();
+    void addToGrid(int index);
+    void cellRange(const Rect &r, int *x0, int *y0, int *x1, int *y1) const;
+
+    Rect m_bounds;
+    QDataBuffer<Rect> m_rects;
+    QDataBuffer<int> m_largeRects;
+    QDataBuffer<Entry> m_entries;
+    int m_cells[GridSize * GridSize];
+    Pt m_origin;
+    Pt m_scale;
+    bool m_hasGrid;
+};
+
+/*
+    Holds the largest opaque rects seen so far while walking the opaque
+    elements front to back, and answers whether a rect is hidden behind one
+    of them. Rects are only compared to rects under the same batch root and
+    clip, as those share a coordinate system and are clipped the same way.
+ */
+class Q_QUICK_PRIVATE_EXPORT OcclusionBuffer
+{
+public:
+    OcclusionBuffer() : m_count(0) { }
+
+    void clear() { m_count = 0; }
+    void add(const Rect &r, const Node *root, const QSGClipNode *clip);
+    bool isOccluded(const Rect &r, const Node *root, const QSGClipNode *clip) const;
+    int count() const { return m_count; }
+
+    static bool fillsBounds(QSGGeometry *g);
+    static bool isOpaqueMaterial(QSGMaterial *m);
+
+    enum {
+        MaxOccluders = 32,
+        MaxOccluderVertices = 64
+    };
+
+private:
+    struct Occluder {
+        Rect rect;
+        float area;
+        const Node *root;
+        const QSGClipNode *clip;
+    };
+
+    Occluder m_occluders[MaxOccluders];
+    int m_count;
+};
+
 struct Buffer {
     GLuint id;
     int size;
     char *data;
 };
 
+struct UploadSlot {
+    UploadSlot() : partialUpload(false), partialIndexUpload(false) { }
+
+    // Contents of the batch buffers as last uploaded, see Renderer::unmapChanges()
+    QByteArray previousVertexData;
+    QByteArray previousIndexData;
+    bool partialUpload;
+    bool partialIndexUpload;
+};
+
 struct Element {
 
     Element(QSGGeometryNode *n)
@@ -163,6 +262,7 @@ struct Element {
         , removed(false)
         , orphaned(false)
         , isRenderNode(false)
+        , occluded(false)
     {
     }
 
@@ -187,6 +287,7 @@ struct Element {
     uint removed : 1;
     uint orphaned : 1;
     uint isRenderNode : 1;
+    uint occluded : 1; // only meaningful in opaque batches
 };
 
 struct RenderNodeElement : public Element {
@@ -418,10 +519,12 @@ private:
     };
 
     friend class Updater;
+    friend class BatchFillJob;
 
 
     void map(Buffer *buffer, int size);
     void unmap(Buffer *buffer, bool isIndexBuf = false);
+    void unmapChanges(Buffer *buffer, const char *previous, bool isIndexBuf = false);
 
     void buildRenderListsFromScratch();
     void buildRenderListsForTaggedRoots();
@@ -431,11 +534,15 @@ private:
     void deleteRemovedElements();
     void cleanupBatches(QDataBuffer<Batch *> *batches);
     void prepareOpaqueBatches();
-    bool checkOverlap(int first, int last, const Rect &bounds);
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
+    void cullOccludedElements();
 
-    void uploadBatch(Batch *b);
+    bool prepareBatchUpload(Batch *b, UploadSlot *slot);
+    void fillBatch(Batch *b);
+    void fillBatches();
+    void finishBatchUpload(Batch *b, const UploadSlot *slot);
+    void uploadBatches();
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, quint16 *iBase, int *indexCount);
 
     void renderBatches();
@@ -462,6 +569,7 @@ private:
     QSet<Node *> m_taggedRoots;
     QDataBuffer<Element *> m_opaqueRenderList;
     QDataBuffer<Element *> m_alphaRenderList;
+    OverlapIndex m_alphaOverlaps;
     int m_nextRenderOrder;
     bool m_partialRebuild;
     QSGNode *m_partialRebuildRoot;
@@ -484,9 +592,26 @@ private:
     int m_renderOrderRebuildUpper;
 
     GLuint m_bufferStrategy;
+    bool m_partialUploads;
+    int m_uploadedBytes;
+    int m_uploadedBuffers;
+    int m_partiallyUploadedBuffers;
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
 
+    bool m_occlusionCulling;
+    bool m_occlusionDirty;
+    int m_occludedElements;
+    OcclusionBuffer m_occluders;
+    QDataBuffer<Element *> m_occlusionElements;
+
+    QDataBuffer<Batch *> m_uploadBatches;
+    QVector<UploadSlot> m_uploadSlots;
+    QAtomicInt m_nextBatchToFill;
+    QThreadPool *m_uploadPool;
+    int m_uploadThreadCount;
+    int m_parallelUploadThreshold;
+
     // Stuff used during rendering only...
     ShaderManager *m_shaderManager;
     QSGMaterial *m_currentMaterial;
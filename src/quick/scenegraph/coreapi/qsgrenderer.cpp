@@ -47,6 +47,7 @@
 
 #include <private/qsgadaptationlayer_p.h>
 #include <private/qsgshadersourcebuilder_p.h>
+#include <private/qsgcontext_p.h>
 
 #include <QOpenGLShaderProgram>
 #include <qopenglframebufferobject.h>
@@ -236,6 +237,12 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
 #endif
 
     m_bindable = &bindable;
+
+    // Layers are rendered from within the window's preprocess step, restore what the
+    // enclosing renderer was drawing into when done.
+    const bool wasRenderingToWindow = m_context->isRenderingToWindow();
+    m_context->setRenderingToWindow(m_context->windowRenderer() == this);
+
     preprocess();
 
     QSystrace::begin("graphics", "QSGR::bind", "");
@@ -271,6 +278,7 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
     m_is_rendering = false;
     m_changed_emitted = false;
     m_bindable = 0;
+    m_context->setRenderingToWindow(wasRenderingToWindow);
 
     if (m_vertex_buffer_bound) {
         glBindBuffer(GL_ARRAY_BUFFER, 0);
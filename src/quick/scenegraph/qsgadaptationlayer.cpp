@@ -96,6 +96,21 @@ QSGDistanceFieldGlyphCache::GlyphData &QSGDistanceFieldGlyphCache::glyphData(gly
     return data.value();
 }
 
+/*
+    Sets the bounding rect of a glyph which has not been looked up yet, saving
+    the glyph outline from being extracted. Used for glyphs loaded from disk.
+ */
+void QSGDistanceFieldGlyphCache::setGlyphBoundingRect(glyph_t glyph, const QRectF &boundingRect)
+{
+    if (m_glyphsData.contains(glyph))
+        return;
+
+    GlyphData gd;
+    gd.texture = &s_emptyTexture;
+    gd.boundingRect = boundingRect;
+    m_glyphsData.insert(glyph, gd);
+}
+
 QSGDistanceFieldGlyphCache::Metrics QSGDistanceFieldGlyphCache::glyphMetrics(glyph_t glyph, qreal pixelSize)
 {
     GlyphData &gd = glyphData(glyph);
@@ -233,13 +248,8 @@ void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &g
         gd.texCoord.height = gd.boundingRect.height();
     }
 
-    if (!invalidatedGlyphs.isEmpty()) {
-        QLinkedList<QSGDistanceFieldGlyphConsumer *>::iterator it = m_registeredNodes.begin();
-        while (it != m_registeredNodes.end()) {
-            (*it)->invalidateGlyphs(invalidatedGlyphs);
-            ++it;
-        }
-    }
+    if (!invalidatedGlyphs.isEmpty())
+        invalidateGlyphs(invalidatedGlyphs);
 }
 
 void QSGDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
@@ -279,12 +289,16 @@ void QSGDistanceFieldGlyphCache::setGlyphsTexture(const QVector<glyph_t> &glyphs
         gd.texture = texture;
     }
 
-    if (!invalidatedGlyphs.isEmpty()) {
-        QLinkedList<QSGDistanceFieldGlyphConsumer*>::iterator it = m_registeredNodes.begin();
-        while (it != m_registeredNodes.end()) {
-            (*it)->invalidateGlyphs(invalidatedGlyphs);
-            ++it;
-        }
+    if (!invalidatedGlyphs.isEmpty())
+        invalidateGlyphs(invalidatedGlyphs);
+}
+
+void QSGDistanceFieldGlyphCache::invalidateGlyphs(const QVector<glyph_t> &glyphs)
+{
+    QLinkedList<QSGDistanceFieldGlyphConsumer *>::iterator it = m_registeredNodes.begin();
+    while (it != m_registeredNodes.end()) {
+        (*it)->invalidateGlyphs(glyphs);
+        ++it;
     }
 }
 
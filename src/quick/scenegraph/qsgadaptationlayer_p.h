@@ -238,6 +238,7 @@ protected:
     void setGlyphsPosition(const QList<GlyphPosition> &glyphs);
     void setGlyphsTexture(const QVector<glyph_t> &glyphs, const Texture &tex);
     void markGlyphsToRender(const QVector<glyph_t> &glyphs);
+    void invalidateGlyphs(const QVector<glyph_t> &glyphs);
     inline void removeGlyph(glyph_t glyph);
 
     void updateTexture(GLuint oldTex, GLuint newTex, const QSize &newTexSize);
@@ -246,6 +247,7 @@ protected:
     GLuint textureIdForGlyph(glyph_t glyph) const;
 
     GlyphData &glyphData(glyph_t glyph);
+    void setGlyphBoundingRect(glyph_t glyph, const QRectF &boundingRect);
 
     inline bool isCoreProfile() const { return m_coreProfile; }
 
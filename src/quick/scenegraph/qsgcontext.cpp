@@ -355,6 +355,12 @@ QSGRenderContext::QSGRenderContext(QSGContext *context)
     , m_distanceFieldCacheManager(0)
     , m_brokenIBOs(false)
     , m_serializedRender(false)
+    , m_textureUploadBytes(0)
+    , m_pendingTextureUploads(0)
+    , m_frameAfterTextureUpload(false)
+    , m_windowRenderer(0)
+    , m_renderingToWindow(false)
+    , m_textureUploadPlaceholder(0)
 {
 }
 
@@ -376,6 +382,11 @@ void QSGRenderContext::renderNextFrame(QSGRenderer *renderer, GLuint fboId)
     if (m_serializedRender)
         qsg_framerender_mutex.lock();
 
+    m_textureUploadBytes = 0;
+    m_pendingTextureUploads = 0;
+    m_frameAfterTextureUpload = false;
+    m_windowRenderer = renderer;
+
     if (fboId) {
         QSGBindableFboId bindable(fboId);
         renderer->renderScene(bindable);
@@ -383,9 +394,97 @@ void QSGRenderContext::renderNextFrame(QSGRenderer *renderer, GLuint fboId)
         renderer->renderScene();
     }
 
+    m_windowRenderer = 0;
+
     if (m_serializedRender)
         qsg_framerender_mutex.unlock();
 
+#ifndef QSG_NO_RENDER_TIMING
+    if (textureUploadBudget() > 0 && QQmlProfilerService::enabled) {
+        QQmlProfilerService::sceneGraphFrame(
+                    QQmlProfilerService::SceneGraphTextureUploadQueue,
+                    m_pendingTextureUploads,
+                    m_textureUploadBytes);
+    }
+#endif
+}
+
+/*!
+    Returns the number of bytes of texture data which can be uploaded per
+    frame, set in kilobytes with the environment variable
+    QSG_TEXTURE_UPLOAD_BUDGET, or 0 if uploads are not limited.
+ */
+int QSGRenderContext::textureUploadBudget()
+{
+    static int budget = qMax(0, qgetenv("QSG_TEXTURE_UPLOAD_BUDGET").toInt()) * 1024;
+    return budget;
+}
+
+/*!
+    Returns true if a texture upload of \a bytes can be done as part of the
+    frame currently being rendered. When the environment variable
+    QSG_TEXTURE_UPLOAD_BUDGET is set, uploads beyond that many kilobytes per
+    frame are counted as pending and should be retried in a later frame.
+
+    The first upload of a frame is always allowed, so that textures larger
+    than the budget still get uploaded. Only uploads while rendering into the
+    window are held back; layers are not rerendered unless their content
+    changes, so they would keep showing the placeholder. The renderer reports
+    which of the two it is drawing with setRenderingToWindow().
+ */
+bool QSGRenderContext::reserveTextureUpload(int bytes)
+{
+    const int budget = textureUploadBudget();
+    if (budget == 0)
+        return true;
+
+    if (m_textureUploadBytes > 0 && m_textureUploadBytes + bytes > budget) {
+        if (m_renderingToWindow) {
+            ++m_pendingTextureUploads;
+            return false;
+        }
+    }
+
+    m_textureUploadBytes += bytes;
+    return true;
+}
+
+/*!
+    Asks for another frame after the current one, so that the nodes which
+    drew a texture with blending while its upload was pending can pick up
+    that it is opaque in their preprocess step.
+
+    \sa needsFrameAfterTextureUploads()
+ */
+void QSGRenderContext::requestFrameAfterTextureUpload()
+{
+    m_frameAfterTextureUpload = true;
+}
+
+/*!
+    Returns true if the frame just rendered left textures to upload, or
+    uploaded textures whose nodes need updating in the next frame.
+ */
+bool QSGRenderContext::needsFrameAfterTextureUploads() const
+{
+    return m_pendingTextureUploads > 0 || m_frameAfterTextureUpload;
+}
+
+/*!
+    Returns a 1x1 fully transparent texture which can be bound in place of a
+    texture whose upload has been postponed.
+ */
+GLuint QSGRenderContext::textureUploadPlaceholder()
+{
+    if (!m_textureUploadPlaceholder) {
+        const quint32 transparent = 0;
+        glGenTextures(1, &m_textureUploadPlaceholder);
+        glBindTexture(GL_TEXTURE_2D, m_textureUploadPlaceholder);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &transparent);
+    }
+    return m_textureUploadPlaceholder;
 }
 
 /*!
@@ -492,6 +591,11 @@ void QSGRenderContext::invalidate()
     qDeleteAll(m_textures.values());
     m_textures.clear();
 
+    if (m_textureUploadPlaceholder) {
+        glDeleteTextures(1, &m_textureUploadPlaceholder);
+        m_textureUploadPlaceholder = 0;
+    }
+
     /* The cleanup of the atlas textures is a bit intriguing.
        As part of the cleanup in the threaded render loop, we
        do:
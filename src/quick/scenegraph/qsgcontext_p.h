@@ -115,6 +115,16 @@ public:
 
     bool hasBrokenIndexBufferObjects() const { return m_brokenIBOs; }
 
+    static int textureUploadBudget();
+    bool reserveTextureUpload(int bytes);
+    GLuint textureUploadPlaceholder();
+    int pendingTextureUploads() const { return m_pendingTextureUploads; }
+    void requestFrameAfterTextureUpload();
+    bool needsFrameAfterTextureUploads() const;
+    void setRenderingToWindow(bool window) { m_renderingToWindow = window; }
+    bool isRenderingToWindow() const { return m_renderingToWindow; }
+    QSGRenderer *windowRenderer() const { return m_windowRenderer; }
+
 Q_SIGNALS:
     void initialized();
     void invalidated();
@@ -138,6 +148,13 @@ protected:
 
     bool m_brokenIBOs;
     bool m_serializedRender;
+
+    int m_textureUploadBytes;
+    int m_pendingTextureUploads;
+    bool m_frameAfterTextureUpload;
+    QSGRenderer *m_windowRenderer;
+    bool m_renderingToWindow;
+    GLuint m_textureUploadPlaceholder;
 };
 
 
@@ -47,6 +47,14 @@
 #include <QtQuick/private/qsgdistancefieldutil_p.h>
 #include <qopenglfunctions.h>
 #include <qmath.h>
+#include <QtQuick/qquickitem.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qlockfile.h>
 
 #if !defined(QT_OPENGL_ES_2)
 #include <QtGui/qopenglfunctions_3_2_core.h>
@@ -56,6 +64,163 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(qmlUseGlyphCacheWorkaround, QML_USE_GLYPHCACHE_WORKAROUND)
 
+Q_GLOBAL_STATIC(QThreadPool, qsg_distanceFieldThreadPool)
+
+static const quint32 qsg_distanceFieldCacheMagic = 0x51534446; // "QSDF"
+static const quint32 qsg_distanceFieldCacheVersion = 2;
+// No more glyphs are written once a cache file reaches this size
+static const qint64 qsg_distanceFieldCacheMaxSize = 16 * 1024 * 1024;
+// How long to wait for another process using the same cache file
+static const int qsg_distanceFieldCacheLockTimeout = 100;
+
+/*
+    Distance fields stored on disk are identified by the font's own tables,
+    so that they follow the font file rather than its path, and by all the
+    parameters which affect the generated fields.
+ */
+static QString qsg_distanceFieldCacheFileName(const QRawFont &font, bool doubleResolution)
+{
+    QByteArray head = font.fontTable("head");
+    if (head.isEmpty())
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(head);
+    hash.addData(font.fontTable("name"));
+    hash.addData(font.fontTable("maxp"));
+    hash.addData(font.familyName().toUtf8());
+    hash.addData(font.styleName().toUtf8());
+    hash.addData(QByteArray::number(font.weight()) + ' ' + QByteArray::number(int(font.style())));
+    hash.addData(QByteArray::number(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution)) + ' '
+                 + QByteArray::number(QT_DISTANCEFIELD_SCALE(doubleResolution)) + ' '
+                 + QByteArray::number(QT_DISTANCEFIELD_RADIUS(doubleResolution)) + ' '
+                 + QByteArray::number(QT_DISTANCEFIELD_TILESIZE(doubleResolution)) + ' '
+                 + QByteArray::number(doubleResolution));
+    return QString::fromLatin1(hash.result().toHex()) + QLatin1String(".qsgdf");
+}
+
+void QSGDistanceFieldDiskCache::writeHeader(QDataStream &out)
+{
+    out.setVersion(QDataStream::Qt_5_0);
+    out << qsg_distanceFieldCacheMagic << qsg_distanceFieldCacheVersion;
+}
+
+bool QSGDistanceFieldDiskCache::readHeader(QDataStream &in)
+{
+    in.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    return in.status() == QDataStream::Ok
+            && magic == qsg_distanceFieldCacheMagic && version == qsg_distanceFieldCacheVersion;
+}
+
+/*
+    Each record is written as a byte array holding the glyph index, its
+    bounding rect, the size of the distance field and the field itself,
+    followed by the checksum of that byte array.
+ */
+void QSGDistanceFieldDiskCache::writeRecord(QDataStream &out, const Record &record)
+{
+    const QDistanceField &field = record.field;
+    QByteArray data;
+    QDataStream fields(&data, QIODevice::WriteOnly);
+    fields.setVersion(QDataStream::Qt_5_0);
+    fields << quint32(record.glyph) << record.boundingRect
+           << qint32(field.width()) << qint32(field.height());
+    fields.writeRawData(reinterpret_cast<const char *>(field.constBits()), field.width() * field.height());
+
+    out << data << qChecksum(data.constData(), data.size());
+}
+
+/*
+    Returns false for a truncated record or one which does not match its
+    checksum, after which the rest of the file cannot be trusted either.
+ */
+bool QSGDistanceFieldDiskCache::readRecord(QDataStream &in, Record *record)
+{
+    QByteArray data;
+    quint16 checksum = 0;
+    in >> data >> checksum;
+    if (in.status() != QDataStream::Ok || data.isEmpty()
+            || qChecksum(data.constData(), data.size()) != checksum) {
+        return false;
+    }
+
+    QDataStream fields(data);
+    fields.setVersion(QDataStream::Qt_5_0);
+    quint32 glyph;
+    qint32 width;
+    qint32 height;
+    fields >> glyph >> record->boundingRect >> width >> height;
+    if (fields.status() != QDataStream::Ok || width <= 0 || height <= 0
+            || qint64(width) * height != data.size() - fields.device()->pos()) {
+        return false;
+    }
+
+    record->glyph = glyph;
+    record->field = QDistanceField(width, height);
+    fields.readRawData(reinterpret_cast<char *>(record->field.scanLine(0)), width * height);
+    return true;
+}
+
+/*
+    Renders the distance fields of a set of glyph outlines. Only the outlines
+    are handed over to the thread, as the font engine is not thread-safe.
+ */
+class QSGDistanceFieldGlyphJob : public QRunnable
+{
+public:
+    QSGDistanceFieldGlyphJob(const QSharedPointer<QSGDefaultDistanceFieldGlyphCache::RenderQueue> &queue, bool doubleResolution)
+        : m_queue(queue)
+        , m_doubleResolution(doubleResolution)
+    {
+    }
+
+    void addGlyph(glyph_t glyph, const QPainterPath &path, quint32 serial)
+    {
+        Glyph g = { glyph, path, serial };
+        m_glyphs.append(g);
+    }
+
+    int glyphCount() const { return m_glyphs.size(); }
+
+    void run()
+    {
+        {
+            QMutexLocker locker(&m_queue->mutex);
+            if (!m_queue->cache)
+                return;
+        }
+
+        QList<QSGDefaultDistanceFieldGlyphCache::RenderedGlyph> rendered;
+        for (int i = 0; i < m_glyphs.size(); ++i) {
+            const Glyph &g = m_glyphs.at(i);
+            QSGDefaultDistanceFieldGlyphCache::RenderedGlyph r;
+            r.field = QDistanceField(g.path, g.glyph, m_doubleResolution);
+            r.serial = g.serial;
+            rendered.append(r);
+        }
+
+        QMutexLocker locker(&m_queue->mutex);
+        if (m_queue->cache) {
+            m_queue->rendered += rendered;
+            emit m_queue->cache->glyphsPending();
+        }
+    }
+
+private:
+    struct Glyph {
+        glyph_t glyph;
+        QPainterPath path;
+        quint32 serial;
+    };
+
+    QSharedPointer<QSGDefaultDistanceFieldGlyphCache::RenderQueue> m_queue;
+    QVector<Glyph> m_glyphs;
+    bool m_doubleResolution;
+};
+
 QSGDefaultDistanceFieldGlyphCache::QSGDefaultDistanceFieldGlyphCache(QSGDistanceFieldGlyphCacheManager *man, QOpenGLContext *c, const QRawFont &font)
     : QSGDistanceFieldGlyphCache(man, c, font)
     , m_maxTextureSize(0)
@@ -65,7 +230,17 @@ QSGDefaultDistanceFieldGlyphCache::QSGDefaultDistanceFieldGlyphCache(QSGDistance
 #if !defined(QT_OPENGL_ES_2)
     , m_funcs(0)
 #endif
+    , m_renderQueue(new RenderQueue)
+    , m_renderSerial(0)
+    , m_diskCacheEnd(0)
 {
+    // Requests for more than this many new glyphs are rendered on worker
+    // threads, so that showing a lot of new text does not stall rendering.
+    // Zero or less disables this.
+    QByteArray threshold = qgetenv("QSG_DISTANCEFIELD_BACKGROUND_THRESHOLD");
+    m_backgroundThreshold = threshold.isEmpty() ? 32 : threshold.toInt();
+    m_renderQueue->cache = this;
+
     m_blitVertexCoordinateArray[0] = -1.0f;
     m_blitVertexCoordinateArray[1] = -1.0f;
     m_blitVertexCoordinateArray[2] =  1.0f;
@@ -85,10 +260,25 @@ QSGDefaultDistanceFieldGlyphCache::QSGDefaultDistanceFieldGlyphCache(QSGDistance
     m_blitTextureCoordinateArray[7] = 1.0f;
 
     m_areaAllocator = new QSGAreaAllocator(QSize(maxTextureSize(), m_maxTextureCount * maxTextureSize()));
+
+    QByteArray cacheDir = qgetenv("QSG_DISTANCEFIELD_CACHE_DIR");
+    if (!cacheDir.isEmpty()) {
+        QString fileName = qsg_distanceFieldCacheFileName(referenceFont(), doubleGlyphResolution());
+        if (!fileName.isEmpty() && QDir().mkpath(QFile::decodeName(cacheDir))) {
+            m_diskCacheFileName = QDir(QFile::decodeName(cacheDir)).filePath(fileName);
+            loadDiskCache();
+        }
+    }
 }
 
 QSGDefaultDistanceFieldGlyphCache::~QSGDefaultDistanceFieldGlyphCache()
 {
+    {
+        // Jobs still running will throw away their result
+        QMutexLocker locker(&m_renderQueue->mutex);
+        m_renderQueue->cache = 0;
+    }
+
     for (int i = 0; i < m_textures.count(); ++i)
         glDeleteTextures(1, &m_textures[i].texture);
 
@@ -122,6 +312,7 @@ void QSGDefaultDistanceFieldGlyphCache::requestGlyphs(const QSet<glyph_t> &glyph
 
                 m_unusedGlyphs.remove(unusedGlyph);
                 m_glyphsTexture.remove(unusedGlyph);
+                m_renderingGlyphs.remove(unusedGlyph);
                 removeGlyph(unusedGlyph);
 
                 alloc = m_areaAllocator->allocate(glyphSize);
@@ -146,10 +337,117 @@ void QSGDefaultDistanceFieldGlyphCache::requestGlyphs(const QSet<glyph_t> &glyph
     }
 
     setGlyphsPosition(glyphPositions);
-    markGlyphsToRender(glyphsToRender);
+    if (m_backgroundThreshold > 0 && glyphsToRender.size() > m_backgroundThreshold)
+        renderGlyphsInBackground(glyphsToRender);
+    else
+        markGlyphsToRender(glyphsToRender);
+}
+
+/*
+    The glyphs have their place in the texture already, but stay invisible
+    until processPendingGlyphs() stores their distance fields. The owning
+    items are told to trigger a new preprocess pass as results come in.
+ */
+void QSGDefaultDistanceFieldGlyphCache::renderGlyphsInBackground(const QVector<glyph_t> &glyphs)
+{
+    if (!m_renderFont.isValid()) {
+        m_renderFont = referenceFont();
+        m_renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleGlyphResolution())
+                                  * QT_DISTANCEFIELD_SCALE(doubleGlyphResolution()));
+    }
+
+    const int glyphsPerJob = 16;
+    QSGDistanceFieldGlyphJob *job = 0;
+    for (int i = 0; i < glyphs.size(); ++i) {
+        if (!job)
+            job = new QSGDistanceFieldGlyphJob(m_renderQueue, doubleGlyphResolution());
+
+        glyph_t glyph = glyphs.at(i);
+        quint32 serial = ++m_renderSerial;
+        m_renderingGlyphs.insert(glyph, serial);
+        job->addGlyph(glyph, m_renderFont.pathForGlyph(glyph), serial);
+
+        if (job->glyphCount() == glyphsPerJob || i == glyphs.size() - 1) {
+            qsg_distanceFieldThreadPool()->start(job);
+            job = 0;
+        }
+    }
+}
+
+void QSGDefaultDistanceFieldGlyphCache::processPendingGlyphs()
+{
+    if (m_renderingGlyphs.isEmpty())
+        return;
+
+    QList<RenderedGlyph> rendered;
+    {
+        QMutexLocker locker(&m_renderQueue->mutex);
+        rendered.swap(m_renderQueue->rendered);
+    }
+
+    // Glyphs which were evicted or requested again while being rendered
+    // have a different serial by now, their result is thrown away.
+    // setGlyphsTexture() only invalidates glyphs which had a texture already, the
+    // others were skipped by the nodes so far and are invalidated here.
+    QList<QDistanceField> fields;
+    QVector<glyph_t> newGlyphs;
+    for (int i = 0; i < rendered.size(); ++i) {
+        const RenderedGlyph &r = rendered.at(i);
+        QHash<glyph_t, quint32>::iterator it = m_renderingGlyphs.find(r.field.glyph());
+        if (it == m_renderingGlyphs.end() || it.value() != r.serial)
+            continue;
+        m_renderingGlyphs.erase(it);
+        fields.append(r.field);
+        if (!glyphTexture(r.field.glyph())->textureId)
+            newGlyphs.append(r.field.glyph());
+    }
+
+    if (fields.isEmpty())
+        return;
+
+    storeGlyphs(fields);
+    if (!newGlyphs.isEmpty())
+        invalidateGlyphs(newGlyphs);
+}
+
+void QSGDefaultDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
+{
+    if (!ownerElement)
+        return;
+
+    Owner &owner = m_owners[ownerElement];
+    if (owner.ref++ == 0) {
+        owner.item = ownerElement;
+        bool ok = connect(this, SIGNAL(glyphsPending()), ownerElement, SLOT(triggerPreprocess()));
+        Q_ASSERT_X(ok, Q_FUNC_INFO, "QML element that owns a glyph node must have triggerPreprocess() slot");
+        Q_UNUSED(ok);
+    }
+}
+
+void QSGDefaultDistanceFieldGlyphCache::unregisterOwnerElement(QQuickItem *ownerElement)
+{
+    QHash<QQuickItem *, Owner>::iterator it = m_owners.find(ownerElement);
+    if (it != m_owners.end() && --it->ref <= 0) {
+        if (it->item)
+            disconnect(this, SIGNAL(glyphsPending()), ownerElement, SLOT(triggerPreprocess()));
+        m_owners.erase(it);
+    }
 }
 
 void QSGDefaultDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &glyphs)
+{
+    QVector<glyph_t> glyphIndexes;
+    glyphIndexes.reserve(glyphs.size());
+    for (int i = 0; i < glyphs.size(); ++i)
+        glyphIndexes.append(glyphs.at(i).glyph());
+
+    uploadGlyphs(glyphIndexes, glyphs);
+
+    if (!m_diskCacheFileName.isEmpty())
+        appendToDiskCache(glyphIndexes, glyphs);
+}
+
+void QSGDefaultDistanceFieldGlyphCache::uploadGlyphs(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs)
 {
     QHash<TextureInfo *, QVector<glyph_t> > glyphTextures;
 
@@ -161,7 +459,7 @@ void QSGDefaultDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField>
 
     for (int i = 0; i < glyphs.size(); ++i) {
         QDistanceField glyph = glyphs.at(i);
-        glyph_t glyphIndex = glyph.glyph();
+        glyph_t glyphIndex = glyphIndexes.at(i);
         TexCoord c = glyphTexCoord(glyphIndex);
         TextureInfo *texInfo = m_glyphsTexture.value(glyphIndex);
 
@@ -216,6 +514,135 @@ void QSGDefaultDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField>
     }
 }
 
+/*
+    Loads the distance fields saved by earlier runs and puts them into the
+    texture right away, as unused glyphs. They are evicted like any other
+    unused glyph when space is needed. The end of the last complete record
+    is remembered, so that new glyphs are appended after it rather than
+    after a broken one.
+ */
+void QSGDefaultDistanceFieldGlyphCache::loadDiskCache()
+{
+    QLockFile lock(m_diskCacheFileName + QLatin1String(".lock"));
+    if (!lock.tryLock(qsg_distanceFieldCacheLockTimeout))
+        return;
+
+    QFile file(m_diskCacheFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    if (!QSGDistanceFieldDiskCache::readHeader(in))
+        return;
+    m_diskCacheEnd = file.pos();
+
+    QList<GlyphPosition> glyphPositions;
+    QVector<glyph_t> glyphIndexes;
+    QList<QDistanceField> glyphs;
+
+    const int tileSize = QT_DISTANCEFIELD_TILESIZE(doubleGlyphResolution());
+    QSGDistanceFieldDiskCache::Record record;
+    while (!in.atEnd() && QSGDistanceFieldDiskCache::readRecord(in, &record)) {
+        const glyph_t glyphIndex = record.glyph;
+        if (int(glyphIndex) >= glyphCount()
+                || record.field.width() > maxTextureSize()
+                || record.field.height() != tileSize) {
+            break;
+        }
+        m_diskCacheEnd = file.pos();
+
+        if (m_diskCachedGlyphs.contains(glyphIndex))
+            continue;
+        m_diskCachedGlyphs.insert(glyphIndex);
+
+        setGlyphBoundingRect(glyphIndex, record.boundingRect);
+
+        int glyphWidth = qCeil(glyphData(glyphIndex).boundingRect.width()) + distanceFieldRadius() * 2;
+        QRect alloc = m_areaAllocator->allocate(QSize(glyphWidth, tileSize));
+        if (alloc.isNull())
+            continue;
+
+        TextureInfo *tex = textureInfo(alloc.y() / maxTextureSize());
+        alloc = QRect(alloc.x(), alloc.y() % maxTextureSize(), alloc.width(), alloc.height());
+        tex->allocatedArea |= alloc;
+
+        GlyphPosition p;
+        p.glyph = glyphIndex;
+        p.position = alloc.topLeft();
+
+        glyphPositions.append(p);
+        glyphIndexes.append(glyphIndex);
+        glyphs.append(record.field);
+        m_glyphsTexture.insert(glyphIndex, tex);
+        m_unusedGlyphs.insert(glyphIndex);
+    }
+
+    if (glyphs.isEmpty())
+        return;
+
+    setGlyphsPosition(glyphPositions);
+    uploadGlyphs(glyphIndexes, glyphs);
+}
+
+/*
+    Other processes showing the same font append to the same file, so it is
+    only written with the lock held. If the file is not as this cache left
+    it, the end of its last good record is looked up again before appending,
+    and a file without a valid header is started over.
+ */
+void QSGDefaultDistanceFieldGlyphCache::appendToDiskCache(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs)
+{
+    QLockFile lock(m_diskCacheFileName + QLatin1String(".lock"));
+    if (!lock.tryLock(qsg_distanceFieldCacheLockTimeout))
+        return;
+
+    QFile file(m_diskCacheFileName);
+    if (!file.open(QIODevice::ReadWrite)) {
+        m_diskCacheFileName.clear();
+        return;
+    }
+
+    if (m_diskCacheEnd == 0 || file.size() != m_diskCacheEnd) {
+        QDataStream in(&file);
+        if (QSGDistanceFieldDiskCache::readHeader(in)) {
+            m_diskCacheEnd = file.pos();
+            QSGDistanceFieldDiskCache::Record record;
+            while (!in.atEnd() && QSGDistanceFieldDiskCache::readRecord(in, &record)) {
+                m_diskCachedGlyphs.insert(record.glyph);
+                m_diskCacheEnd = file.pos();
+            }
+            file.resize(m_diskCacheEnd);
+        } else {
+            file.resize(0);
+            file.seek(0);
+            QDataStream header(&file);
+            QSGDistanceFieldDiskCache::writeHeader(header);
+            m_diskCacheEnd = file.pos();
+            m_diskCachedGlyphs.clear();
+        }
+    }
+    file.seek(m_diskCacheEnd);
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    for (int i = 0; i < glyphs.size(); ++i) {
+        glyph_t glyphIndex = glyphIndexes.at(i);
+        if (m_diskCachedGlyphs.contains(glyphIndex))
+            continue;
+
+        QSGDistanceFieldDiskCache::Record record;
+        record.glyph = glyphIndex;
+        record.boundingRect = glyphData(glyphIndex).boundingRect;
+        record.field = glyphs.at(i);
+        if (m_diskCacheEnd + record.field.width() * record.field.height() > qsg_distanceFieldCacheMaxSize)
+            break;
+        m_diskCachedGlyphs.insert(glyphIndex);
+
+        QSGDistanceFieldDiskCache::writeRecord(out, record);
+        m_diskCacheEnd = file.pos();
+    }
+}
+
 void QSGDefaultDistanceFieldGlyphCache::referenceGlyphs(const QSet<glyph_t> &glyphs)
 {
     m_unusedGlyphs -= glyphs;
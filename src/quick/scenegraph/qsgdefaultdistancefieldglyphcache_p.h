@@ -47,6 +47,10 @@
 #include <qopenglshaderprogram.h>
 #include <QtGui/private/qopenglengineshadersource_p.h>
 #include <private/qsgareaallocator_p.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qdatastream.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -55,8 +59,26 @@ class QOpenGLSharedResourceGuard;
 class QOpenGLFunctions_3_2_Core;
 #endif
 
-class Q_QUICK_PRIVATE_EXPORT QSGDefaultDistanceFieldGlyphCache : public QSGDistanceFieldGlyphCache
+// The format of the files in QSG_DISTANCEFIELD_CACHE_DIR: a header followed by one
+// checksummed record per glyph.
+class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldDiskCache
 {
+public:
+    struct Record {
+        glyph_t glyph;
+        QRectF boundingRect;
+        QDistanceField field;
+    };
+
+    static void writeHeader(QDataStream &out);
+    static bool readHeader(QDataStream &in);
+    static void writeRecord(QDataStream &out, const Record &record);
+    static bool readRecord(QDataStream &in, Record *record);
+};
+
+class Q_QUICK_PRIVATE_EXPORT QSGDefaultDistanceFieldGlyphCache : public QObject, public QSGDistanceFieldGlyphCache
+{
+    Q_OBJECT
 public:
     QSGDefaultDistanceFieldGlyphCache(QSGDistanceFieldGlyphCacheManager *man, QOpenGLContext *c, const QRawFont &font);
     virtual ~QSGDefaultDistanceFieldGlyphCache();
@@ -66,6 +88,10 @@ public:
     void referenceGlyphs(const QSet<glyph_t> &glyphs);
     void releaseGlyphs(const QSet<glyph_t> &glyphs);
 
+    void registerOwnerElement(QQuickItem *ownerElement);
+    void unregisterOwnerElement(QQuickItem *ownerElement);
+    void processPendingGlyphs();
+
     bool useTextureResizeWorkaround() const;
     bool useTextureUploadWorkaround() const;
     int maxTextureSize() const;
@@ -73,7 +99,31 @@ public:
     void setMaxTextureCount(int max) { m_maxTextureCount = max; }
     int maxTextureCount() const { return m_maxTextureCount; }
 
+    struct RenderedGlyph {
+        QDistanceField field;
+        quint32 serial;
+    };
+
+    // Shared with the threads rendering distance fields in the background,
+    // which may outlive the cache.
+    struct RenderQueue {
+        RenderQueue() : cache(0) { }
+
+        QMutex mutex;
+        QList<RenderedGlyph> rendered;
+        QSGDefaultDistanceFieldGlyphCache *cache;
+    };
+
+Q_SIGNALS:
+    void glyphsPending();
+
 private:
+    void renderGlyphsInBackground(const QVector<glyph_t> &glyphs);
+    void uploadGlyphs(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs);
+
+    void loadDiskCache();
+    void appendToDiskCache(const QVector<glyph_t> &glyphIndexes, const QList<QDistanceField> &glyphs);
+
     struct TextureInfo {
         GLuint texture;
         QSize size;
@@ -140,6 +190,25 @@ private:
 #if !defined(QT_OPENGL_ES_2)
     QOpenGLFunctions_3_2_Core *m_funcs;
 #endif
+
+    int m_backgroundThreshold;
+    QRawFont m_renderFont;
+    QSharedPointer<RenderQueue> m_renderQueue;
+    QHash<glyph_t, quint32> m_renderingGlyphs;
+    quint32 m_renderSerial;
+
+    struct Owner
+    {
+        Owner() : ref(0) {}
+
+        QPointer<QQuickItem> item;
+        int ref;
+    };
+    QHash<QQuickItem *, Owner> m_owners;
+
+    QString m_diskCacheFileName;
+    qint64 m_diskCacheEnd;
+    QSet<glyph_t> m_diskCachedGlyphs;
 };
 
 QT_END_NAMESPACE
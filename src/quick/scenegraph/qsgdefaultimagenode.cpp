@@ -48,6 +48,7 @@
 
 #include <qsgtexturematerial.h>
 #include <private/qsgtexturematerial_p.h>
+#include <private/qsgtexture_p.h>
 #include <qsgmaterial.h>
 
 QT_BEGIN_NAMESPACE
@@ -249,6 +250,11 @@ void QSGDefaultImageNode::setTexture(QSGTexture *texture)
     m_smoothMaterial.setTexture(texture);
     m_material.setFlag(QSGMaterial::Blending, texture->hasAlphaChannel());
 
+    // A texture waiting for its upload is blended until then, preprocess() notices when
+    // it is done.
+    QSGPlainTexture *plainTexture = qobject_cast<QSGPlainTexture *>(texture);
+    setFlag(UsePreprocess, plainTexture && plainTexture->isBlendedUntilUploaded());
+
     markDirty(DirtyMaterial);
 
     // Because the texture can be a different part of the atlas, we need to update it...
@@ -303,6 +309,10 @@ void QSGDefaultImageNode::preprocess()
         doDirty = true;
     }
 
+    QSGPlainTexture *plainTexture = qobject_cast<QSGPlainTexture *>(m_material.texture());
+    if (!plainTexture || !plainTexture->isBlendedUntilUploaded())
+        setFlag(UsePreprocess, false);
+
     if (doDirty)
         markDirty(DirtyMaterial);
 }
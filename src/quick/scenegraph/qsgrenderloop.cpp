@@ -82,6 +82,15 @@ QSGRenderLoop::~QSGRenderLoop()
 {
 }
 
+/*!
+    Returns how long the phases of the last frame rendered for \a window
+    took. The default implementation does not measure anything.
+ */
+QSGFrameTimings QSGRenderLoop::frameTimings(QQuickWindow *) const
+{
+    return QSGFrameTimings();
+}
+
 void QSGRenderLoop::cleanup()
 {
     if (!s_instance)
@@ -123,11 +132,16 @@ public:
     QSGContext *sceneGraphContext() const;
     QSGRenderContext *createRenderContext(QSGContext *) const { return rc; }
 
+    QSGFrameTimings frameTimings(QQuickWindow *window) const { return m_windows.value(window).timings; }
+
     bool event(QEvent *);
 
     struct WindowData {
+        WindowData() : updatePending(false), grabOnly(false) { }
         bool updatePending : 1;
         bool grabOnly : 1;
+        QSGFrameTimings timings;
+        QElapsedTimer lastFrame;
     };
 
     QHash<QQuickWindow *, WindowData> m_windows;
@@ -322,23 +336,21 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         if (!m_windows.contains(window))
             return;
     }
-    cd->polishItems();
-
     qint64 renderTime = 0, syncTime = 0;
     QElapsedTimer renderTimer;
-    bool profileFrames = qsg_render_timing()  || QQmlProfilerService::enabled;
-    if (profileFrames)
-        renderTimer.start();
+    renderTimer.start();
+
+    cd->polishItems();
+
+    qint64 polishTime = renderTimer.nsecsElapsed();
 
     cd->syncSceneGraph();
 
-    if (profileFrames)
-        syncTime = renderTimer.nsecsElapsed();
+    syncTime = renderTimer.nsecsElapsed() - polishTime;
 
     cd->renderSceneGraph(window->size());
 
-    if (profileFrames)
-        renderTime = renderTimer.nsecsElapsed() - syncTime;
+    renderTime = renderTimer.nsecsElapsed() - syncTime - polishTime;
 
     if (data.grabOnly) {
         grabContent = qt_gl_read_framebuffer(window->size(), false, false);
@@ -350,10 +362,17 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         cd->fireFrameSwapped();
     }
 
-    qint64 swapTime = 0;
-    if (profileFrames) {
-        swapTime = renderTimer.nsecsElapsed() - renderTime - syncTime;
-    }
+    qint64 swapTime = renderTimer.nsecsElapsed() - renderTime - syncTime - polishTime;
+
+    // Everything happens on the gui thread, which only waits for itself to sync
+    data.timings.polish = polishTime;
+    data.timings.wait = syncTime;
+    data.timings.sync = syncTime;
+    data.timings.animations = 0;
+    data.timings.render = renderTime;
+    data.timings.swap = swapTime;
+    data.timings.frameInterval = data.lastFrame.isValid() ? data.lastFrame.nsecsElapsed() : -1;
+    data.lastFrame.start();
 
     if (qsg_render_timing()) {
         static QTime lastFrameTime = QTime::currentTime();
@@ -53,6 +53,34 @@ class QSGContext;
 class QSGRenderContext;
 class QAnimationDriver;
 
+/*
+    Durations of the phases of the last frame of a window, in nanoseconds.
+    Phases which a render loop does not have, or has not measured yet, are -1.
+ */
+struct QSGFrameTimings
+{
+    QSGFrameTimings()
+        : polish(-1)
+        , wait(-1)
+        , sync(-1)
+        , animations(-1)
+        , render(-1)
+        , swap(-1)
+        , frameInterval(-1)
+    {
+    }
+
+    bool isValid() const { return render >= 0; }
+
+    qint64 polish;          // polishing items
+    qint64 wait;            // gui thread blocked for the sync, including it
+    qint64 sync;
+    qint64 animations;      // advancing animations on the gui thread
+    qint64 render;
+    qint64 swap;
+    qint64 frameInterval;   // since the start of the previous frame
+};
+
 class Q_QUICK_PRIVATE_EXPORT QSGRenderLoop : public QObject
 {
     Q_OBJECT
@@ -91,6 +119,8 @@ public:
 
     virtual bool interleaveIncubation() const { return false; }
 
+    virtual QSGFrameTimings frameTimings(QQuickWindow *window) const;
+
     static void cleanup();
 
 Q_SIGNALS:
@@ -142,6 +142,16 @@ static inline int qsgrl_animation_interval() {
     return int(1000 / refreshRate);
 }
 
+static inline qint64 qsgrl_vsync_interval_ns() {
+    qreal refreshRate = QGuiApplication::primaryScreen()->refreshRate();
+    if (refreshRate < 1)
+        return 16666667;
+    return qint64(1000000000 / refreshRate);
+}
+
+// Shared by the gui and render threads to place frames relative to each other
+static QElapsedTimer qsgrl_frame_clock;
+
 
 #ifndef QSG_NO_RENDER_TIMING
 static bool qsg_render_timing = !qgetenv("QSG_RENDER_TIMING").isEmpty();
@@ -292,6 +302,8 @@ public:
         , active(false)
         , window(0)
         , stopEventProcessing(false)
+        , lastFrameStart(-1)
+        , lastSwap(-1)
     {
         vsyncDelta = qsgrl_animation_interval();
     }
@@ -358,6 +370,13 @@ public:
 
     // Local event queue stuff...
     bool stopEventProcessing;
+
+    // Render thread phases of the last frame and when its swap returned, on
+    // qsgrl_frame_clock. Read from the gui thread under timingMutex.
+    QMutex timingMutex;
+    QSGFrameTimings timings;
+    qint64 lastFrameStart;
+    qint64 lastSwap;
     QSGRenderThreadEventQueue eventQueue;
 };
 
@@ -552,6 +571,7 @@ void QSGRenderThread::syncAndRender()
         threadTimer.start();
     }
 #endif
+    const qint64 frameStart = qsgrl_frame_clock.nsecsElapsed();
     QElapsedTimer waitTimer;
     waitTimer.start();
 
@@ -568,6 +588,7 @@ void QSGRenderThread::syncAndRender()
         QSG_RT_DEBUG(" - update pending, doing sync");
         sync();
     }
+    const qint64 syncDone = waitTimer.nsecsElapsed();
 
     if (!syncResultedInChanges && !(repaintRequested)) {
         QSG_RT_DEBUG(" - no changes, rendering aborted");
@@ -605,11 +626,21 @@ void QSGRenderThread::syncAndRender()
         if (profileFrames)
             renderTime = threadTimer.nsecsElapsed();
 #endif
+        const qint64 renderDone = waitTimer.nsecsElapsed();
         {
             QSystraceEvent systrace("graphics", "QSGRT::swapBuffers");
             gl->swapBuffers(window);
             d->fireFrameSwapped();
         }
+        const qint64 swapDone = waitTimer.nsecsElapsed();
+
+        QMutexLocker locker(&timingMutex);
+        timings.sync = syncRequested ? syncDone : 0;
+        timings.render = renderDone - syncDone;
+        timings.swap = swapDone - renderDone;
+        timings.frameInterval = lastFrameStart >= 0 ? frameStart - lastFrameStart : -1;
+        lastFrameStart = frameStart;
+        lastSwap = frameStart + swapDone;
     } else {
         QSG_RT_DEBUG(" - Window not yet ready, skipping render...");
     }
@@ -715,6 +746,10 @@ QSGThreadedRenderLoop::QSGThreadedRenderLoop()
     m_animation_driver = sg->createAnimationDriver(this);
 
     m_exhaust_delay = get_env_int("QML_EXHAUST_DELAY", 5);
+    m_frame_pacing = get_env_int("QSG_FRAME_PACING", 0) != 0;
+
+    if (!qsgrl_frame_clock.isValid())
+        qsgrl_frame_clock.start();
 
     connect(m_animation_driver, SIGNAL(started()), this, SLOT(animationStarted()));
     connect(m_animation_driver, SIGNAL(stopped()), this, SLOT(animationStopped()));
@@ -732,10 +767,55 @@ void QSGThreadedRenderLoop::maybePostPolishRequest(Window *w)
 {
     if (w->timerId == 0) {
         QSG_GUI_DEBUG(w->window, " - posting update");
-        w->timerId = startTimer(m_exhaust_delay, Qt::PreciseTimer);
+        int delay = m_frame_pacing ? pacedPolishDelay(w) : m_exhaust_delay;
+        w->timerId = startTimer(delay, Qt::PreciseTimer);
     }
 }
 
+/*
+    While the render thread renders continuously, the next sync can not
+    happen before its current swap returns at the next vsync. Rather than
+    polishing after a fixed delay and then blocking until then, polish as late
+    as the expected polish time allows, so that the polish is done right when
+    the render thread is ready to sync. This leaves the gui thread free for
+    longer and makes the synced state as recent as possible.
+ */
+int QSGThreadedRenderLoop::pacedPolishDelay(Window *w) const
+{
+    qint64 lastSwap;
+    {
+        QMutexLocker locker(&w->thread->timingMutex);
+        lastSwap = w->thread->lastSwap;
+    }
+
+    const qint64 interval = qsgrl_vsync_interval_ns();
+    const qint64 now = qsgrl_frame_clock.nsecsElapsed();
+
+    // The render thread is idle, there is nothing to wait for
+    if (lastSwap < 0 || now - lastSwap > interval)
+        return m_exhaust_delay;
+
+    // Leave some room for event delivery and taking the lock
+    const qint64 margin = 2000000;
+    const qint64 delay = lastSwap + interval - now - w->polishEstimate - margin;
+    return delay > 0 ? int(delay / 1000000) : 0;
+}
+
+QSGFrameTimings QSGThreadedRenderLoop::frameTimings(QQuickWindow *window) const
+{
+    Window *w = windowFor(m_windows, window);
+    if (!w)
+        return QSGFrameTimings();
+
+    QSGFrameTimings timings = w->timings;
+    QMutexLocker locker(&w->thread->timingMutex);
+    timings.sync = w->thread->timings.sync;
+    timings.render = w->thread->timings.render;
+    timings.swap = w->thread->timings.swap;
+    timings.frameInterval = w->thread->timings.frameInterval;
+    return timings;
+}
+
 QAnimationDriver *QSGThreadedRenderLoop::animationDriver() const
 {
     return m_animation_driver;
@@ -835,6 +915,7 @@ void QSGThreadedRenderLoop::show(QQuickWindow *window)
     win.thread = new QSGRenderThread(this, QQuickWindowPrivate::get(window)->context);
     win.timerId = 0;
     win.updateDuringSync = false;
+    win.polishEstimate = 0;
     m_windows << win;
 }
 
@@ -1115,25 +1196,23 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w)
     }
 
 
-#ifndef QSG_NO_RENDER_TIMING
     QElapsedTimer timer;
     qint64 polishTime = 0;
+#ifndef QSG_NO_RENDER_TIMING
     qint64 waitTime = 0;
-    qint64 syncTime = 0;
-    bool profileFrames = qsg_render_timing  || QQmlProfilerService::enabled;
-    if (profileFrames)
-        timer.start();
 #endif
+    qint64 syncTime = 0;
+    timer.start();
 
     QSystrace::begin("graphics", "QSGTR::pAS::polish", "");
     QQuickWindowPrivate *d = QQuickWindowPrivate::get(w->window);
     d->polishItems();
     QSystrace::end("graphics", "QSGTR::pAS::polish", "");
 
-#ifndef QSG_NO_RENDER_TIMING
-    if (profileFrames)
-        polishTime = timer.nsecsElapsed();
-#endif
+    polishTime = timer.nsecsElapsed();
+    // Rises right away and decays slowly, so that paced polishing is not
+    // started too late after a single quick frame
+    w->polishEstimate = qMax(polishTime, (w->polishEstimate * 7 + polishTime) / 8);
 
     QSystrace::begin("graphics", "QSGTR::pAS::lock", "");
     w->updateDuringSync = false;
@@ -1145,8 +1224,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w)
 
     QSG_GUI_DEBUG(window, " - wait for sync...");
 #ifndef QSG_NO_RENDER_TIMING
-    if (profileFrames)
-        waitTime = timer.nsecsElapsed();
+    waitTime = timer.nsecsElapsed();
 #endif
     QSystrace::end("graphics", "QSGTR::pAS::lock", "");
     QSystrace::begin("graphics", "QSGTR::pAS::sync", "");
@@ -1157,10 +1235,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w)
     QSG_GUI_DEBUG(window, " - unlocked after sync...");
 
     QSystrace::end("graphics", "QSGTR::pAS::sync", "");
-#ifndef QSG_NO_RENDER_TIMING
-    if (profileFrames)
-        syncTime = timer.nsecsElapsed();
-#endif
+    syncTime = timer.nsecsElapsed();
 
     killTimer(w->timerId);
     w->timerId = 0;
@@ -1180,6 +1255,9 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w)
         maybePostPolishRequest(w);
     }
 
+    w->timings.polish = polishTime;
+    w->timings.wait = syncTime - polishTime;
+    w->timings.animations = timer.nsecsElapsed() - syncTime;
 
 #ifndef QSG_NO_RENDER_TIMING
     if (qsg_render_timing)
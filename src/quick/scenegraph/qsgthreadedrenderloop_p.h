@@ -79,6 +79,8 @@ public:
 
     bool interleaveIncubation() const;
 
+    QSGFrameTimings frameTimings(QQuickWindow *window) const;
+
 public Q_SLOTS:
     void animationStarted();
     void animationStopped();
@@ -89,6 +91,8 @@ private:
         QSGRenderThread *thread;
         int timerId;
         uint updateDuringSync : 1;
+        QSGFrameTimings timings;    // gui thread phases of the last frame
+        qint64 polishEstimate;
     };
 
     friend class QSGRenderThread;
@@ -102,6 +106,7 @@ private:
 
     void startOrStopAnimationTimer();
     void maybePostPolishRequest(Window *w);
+    int pacedPolishDelay(Window *w) const;
     void waitForReleaseComplete();
     void polishAndSync(Window *w);
     void maybeUpdate(Window *window);
@@ -116,6 +121,7 @@ private:
 
     int m_animation_timer;
     int m_exhaust_delay;
+    bool m_frame_pacing;
 
     bool m_locked;
 };
@@ -56,6 +56,8 @@
 
 #include <private/qqmlprofilerservice_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 #ifndef GL_BGRA
@@ -93,7 +95,9 @@ static int qsg_envInt(const char *name, int defaultValue)
 }
 
 Manager::Manager()
-    : m_atlas(0)
+    : m_use_counter(0)
+    , m_has_empty_pages(false)
+    , m_pages_unsorted(false)
 {
     QOpenGLContext *gl = QOpenGLContext::currentContext();
     Q_ASSERT(gl);
@@ -116,41 +120,119 @@ Manager::Manager()
 
     m_atlas_size_limit = qsg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
+    m_atlas_page_limit = qMax(1, qsg_envInt("QSG_ATLAS_PAGE_LIMIT", 4));
 
-    if (qEnvironmentVariableIsSet("QSG_INFO"))
-        qDebug() << "QSG: texture atlas dimensions:" << w << "x" << h;
+    m_info = qEnvironmentVariableIsSet("QSG_INFO");
+    if (m_info)
+        qDebug() << "QSG: texture atlas dimensions:" << w << "x" << h << "pages:" << m_atlas_page_limit;
 }
 
 
 Manager::~Manager()
 {
-    Q_ASSERT(m_atlas == 0);
+    Q_ASSERT(m_atlases.isEmpty());
 }
 
 void Manager::invalidate()
 {
-    if (m_atlas) {
-        m_atlas->invalidate();
-        m_atlas->deleteLater();
-        m_atlas = 0;
+    for (int i=0; i<m_atlases.size(); ++i) {
+        m_atlases.at(i)->invalidate();
+        m_atlases.at(i)->deleteLater();
     }
+    m_atlases.clear();
+}
+
+static bool qsg_atlasMoreUsed(const Atlas *a, const Atlas *b)
+{
+    return a->usedArea() > b->usedArea();
 }
 
+/*
+    Images are placed in the most used page they fit into. This packs new
+    images around the long lived ones, so that pages which only hold a few
+    images drain as those are released and can be given back as a whole.
+    A new page is only added when none of the existing ones has room.
+
+    The pages are kept in that order: a page which gets an image moves
+    ahead of the pages it now uses more than, and the pages are only sorted
+    again after images were removed.
+ */
 QSGTexture *Manager::create(const QImage &image)
 {
-    QSGTexture *t = 0;
+    Texture *t = 0;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
-        if (!m_atlas)
-            m_atlas = new Atlas(m_atlas_size);
-        t = m_atlas->create(image);
+        if (m_has_empty_pages)
+            releaseUnusedPages();
+        if (m_pages_unsorted) {
+            std::stable_sort(m_atlases.begin(), m_atlases.end(), qsg_atlasMoreUsed);
+            m_pages_unsorted = false;
+        }
+
+        for (int i=0; i<m_atlases.size() && !t; ++i) {
+            t = m_atlases.at(i)->create(image);
+            if (t) {
+                for (int j=i; j>0 && qsg_atlasMoreUsed(m_atlases.at(j), m_atlases.at(j - 1)); --j)
+                    m_atlases.swap(j, j - 1);
+            }
+        }
+
+        if (!t && m_atlases.size() < m_atlas_page_limit) {
+            if (m_info) {
+                QDebug info = qDebug();
+                info << "QSG: adding texture atlas page" << m_atlases.size() + 1 << ", usage of existing pages:";
+                for (int i=0; i<m_atlases.size(); ++i)
+                    info << m_atlases.at(i)->usage();
+            }
+            Atlas *atlas = new Atlas(this, m_atlas_size);
+            m_atlases << atlas;
+            t = atlas->create(image);
+        }
     }
     return t;
 }
 
-Atlas::Atlas(const QSize &size)
-    : m_allocator(size)
+void Manager::textureRemoved(Atlas *atlas)
+{
+    m_pages_unsorted = true;
+    if (atlas->textureCount() == 0)
+        m_has_empty_pages = true;
+}
+
+/*
+    Pages without textures are released, except for the most recently used
+    one. Keeping that one around avoids reallocating a page over and over
+    when an application keeps cycling through a set of images.
+ */
+void Manager::releaseUnusedPages()
+{
+    Atlas *spare = 0;
+    for (int i=0; i<m_atlases.size(); ++i) {
+        Atlas *atlas = m_atlases.at(i);
+        if (atlas->textureCount() == 0 && (!spare || atlas->lastUsed() > spare->lastUsed()))
+            spare = atlas;
+    }
+
+    for (int i=m_atlases.size() - 1; i>=0; --i) {
+        Atlas *atlas = m_atlases.at(i);
+        if (atlas->textureCount() == 0 && atlas != spare) {
+            if (m_info)
+                qDebug() << "QSG: releasing unused texture atlas page" << i + 1;
+            atlas->invalidate();
+            atlas->deleteLater();
+            m_atlases.removeAt(i);
+        }
+    }
+    m_has_empty_pages = false;
+}
+
+Atlas::Atlas(Manager *manager, const QSize &size)
+    : m_manager(manager)
+    , m_allocator(size)
     , m_texture_id(0)
     , m_size(size)
+    , m_texture_count(0)
+    , m_used_area(0)
+    , m_last_used(0)
     , m_allocated(false)
 {
 
@@ -196,6 +278,8 @@ Atlas::~Atlas()
 void Atlas::invalidate()
 {
     Q_ASSERT(QOpenGLContext::currentContext());
+    // The page is no longer managed, the manager may be gone before the remaining textures
+    m_manager = 0;
     if (m_texture_id) {
         glDeleteTextures(1, &m_texture_id);
         m_texture_id = 0;
@@ -209,6 +293,8 @@ Texture *Atlas::create(const QImage &image)
     if (rect.width() > 0 && rect.height() > 0) {
         Texture *t = new Texture(this, rect, image);
         m_pending_uploads << t;
+        ++m_texture_count;
+        m_used_area += rect.width() * rect.height();
         return t;
     }
     return 0;
@@ -326,6 +412,9 @@ void Atlas::uploadBgra(Texture *texture)
 
 void Atlas::bind(QSGTexture::Filtering filtering)
 {
+    if (m_manager)
+        m_last_used = m_manager->nextUse();
+
     if (!m_allocated) {
         m_allocated = true;
 
@@ -426,6 +515,10 @@ void Atlas::remove(Texture *t)
     QRect atlasRect = t->atlasSubRect();
     m_allocator.deallocate(atlasRect);
     m_pending_uploads.removeOne(t);
+    --m_texture_count;
+    m_used_area -= atlasRect.width() * atlasRect.height();
+    if (m_manager)
+        m_manager->textureRemoved(this);
 }
 
 
@@ -69,17 +69,30 @@ public:
     QSGTexture *create(const QImage &image);
     void invalidate();
 
+    int pageCount() const { return m_atlases.size(); }
+    uint nextUse() { return ++m_use_counter; }
+    void textureRemoved(Atlas *atlas);
+
 private:
-    Atlas *m_atlas;
+    void releaseUnusedPages();
+
+    // Ordered by used area, the most used page first
+    QList<Atlas *> m_atlases;
 
     QSize m_atlas_size;
     int m_atlas_size_limit;
+    int m_atlas_page_limit;
+    uint m_use_counter;
+
+    uint m_has_empty_pages : 1;
+    uint m_pages_unsorted : 1;
+    uint m_info : 1;
 };
 
 class Atlas : public QObject
 {
 public:
-    Atlas(const QSize &size);
+    Atlas(Manager *manager, const QSize &size);
     ~Atlas();
 
     void invalidate();
@@ -95,12 +108,22 @@ public:
 
     QSize size() const { return m_size; }
 
+    int textureCount() const { return m_texture_count; }
+    int usedArea() const { return m_used_area; }
+    qreal usage() const { return m_used_area / qreal(m_size.width() * m_size.height()); }
+    uint lastUsed() const { return m_last_used; }
+
 private:
+    Manager *m_manager;
     QSGAreaAllocator m_allocator;
     GLuint m_texture_id;
     QSize m_size;
     QList<Texture *> m_pending_uploads;
 
+    int m_texture_count;
+    int m_used_area;
+    uint m_last_used;
+
     GLuint m_internalFormat;
     GLuint m_externalFormat;
 
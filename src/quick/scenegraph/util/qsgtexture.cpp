@@ -540,6 +540,8 @@ QSGPlainTexture::QSGPlainTexture()
     , m_owns_texture(true)
     , m_mipmaps_generated(false)
     , m_retain_image(false)
+    , m_has_content(false)
+    , m_content_has_alpha(false)
 {
 }
 
@@ -596,6 +598,7 @@ void QSGPlainTexture::setTextureId(int id)
     m_dirty_bind_options = true;
     m_image = QImage();
     m_mipmaps_generated = false;
+    m_has_content = id != 0;
 }
 
 void QSGPlainTexture::setHasMipmaps(bool mm)
@@ -605,6 +608,21 @@ void QSGPlainTexture::setHasMipmaps(bool mm)
 }
 
 
+bool QSGPlainTexture::hasAlphaChannel() const
+{
+    return m_has_alpha || isBlendedUntilUploaded();
+}
+
+/*
+    While the upload of an image can be postponed, bind() may show the previous content or
+    a transparent placeholder instead, which must be blended even if the image is opaque.
+ */
+bool QSGPlainTexture::isBlendedUntilUploaded() const
+{
+    return m_dirty_texture && !m_image.isNull() && (!m_has_content || m_content_has_alpha)
+            && QSGRenderContext::textureUploadBudget() > 0;
+}
+
 void QSGPlainTexture::bind()
 {
     if (!m_dirty_texture) {
@@ -619,6 +637,18 @@ void QSGPlainTexture::bind()
         return;
     }
 
+    if (!m_image.isNull()) {
+        QSGRenderContext *rc = QSGRenderContext::from(QOpenGLContext::currentContext());
+        if (rc && !rc->reserveTextureUpload(m_image.width() * m_image.height() * 4)) {
+            // Over this frame's upload budget. Keep showing the previous
+            // content, if any, until the upload happens in a later frame.
+            glBindTexture(GL_TEXTURE_2D, m_has_content ? m_texture_id : rc->textureUploadPlaceholder());
+            return;
+        }
+        if (rc && !m_has_alpha && isBlendedUntilUploaded())
+            rc->requestFrameAfterTextureUpload();
+    }
+
     m_dirty_texture = false;
 
 #ifndef QSG_NO_RENDER_TIMING
@@ -651,6 +681,7 @@ void QSGPlainTexture::bind()
         m_texture_size = QSize();
         m_has_mipmaps = false;
         m_has_alpha = false;
+        m_has_content = false;
 
 
 
@@ -735,6 +766,8 @@ void QSGPlainTexture::bind()
         swizzleTime = qsg_renderer_timer.nsecsElapsed();
 #endif
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
+    m_has_content = true;
+    m_content_has_alpha = m_has_alpha;
 
     QSystrace::end("graphics", "QSGPlainTexture::upload", "");
 
@@ -83,7 +83,8 @@ public:
     QSize textureSize() const { return m_texture_size; }
 
     void setHasAlphaChannel(bool alpha) { m_has_alpha = alpha; }
-    bool hasAlphaChannel() const { return m_has_alpha; }
+    bool hasAlphaChannel() const;
+    bool isBlendedUntilUploaded() const;
 
     void setHasMipmaps(bool mm);
     bool hasMipmaps() const { return m_has_mipmaps; }
@@ -113,6 +114,8 @@ protected:
     uint m_owns_texture : 1;
     uint m_mipmaps_generated : 1;
     uint m_retain_image: 1;
+    uint m_has_content : 1;
+    uint m_content_has_alpha : 1;
 };
 
 QT_END_NAMESPACE
@@ -56,10 +56,13 @@
 #include <QCoreApplication>
 #include <QImageReader>
 #include <QHash>
+#include <QSet>
 #include <QNetworkReply>
 #include <QPixmapCache>
 #include <QFile>
 #include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QWaitCondition>
@@ -146,6 +149,7 @@ public:
 
     bool loading;
     int redirectCount;
+    int priority; // always access inside the reader's mutex
 
     class Event : public QEvent {
     public:
@@ -186,6 +190,23 @@ private:
     QQuickPixmapReader *reader;
 };
 
+class QQuickPixmapDecodeJob : public QRunnable
+{
+public:
+    QQuickPixmapDecodeJob(QQuickPixmapReader *reader, QQuickPixmapReply *reply, const QUrl &url,
+                          const QSize &requestSize, const QString &localFile, const QByteArray &data);
+
+    void run();
+
+private:
+    QQuickPixmapReader *m_reader;
+    QQuickPixmapReply *m_reply;
+    QUrl m_url;
+    QSize m_requestSize;
+    QString m_localFile;
+    QByteArray m_data;
+};
+
 class QQuickPixmapData;
 class QQuickPixmapReader : public QThread
 {
@@ -196,6 +217,7 @@ public:
 
     QQuickPixmapReply *getImage(QQuickPixmapData *);
     void cancel(QQuickPixmapReply *rep);
+    void setPriority(QQuickPixmapReply *rep, int priority);
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -205,12 +227,21 @@ protected:
 
 private:
     friend class QQuickPixmapReaderThreadObject;
+    friend class QQuickPixmapDecodeJob;
     void processJobs();
     void processJob(QQuickPixmapReply *, const QUrl &, const QSize &);
+    QQuickPixmapReply *takeNextJob();
     void networkRequestDone(QNetworkReply *);
 
+    void startDecode(QQuickPixmapReply *, const QUrl &, const QSize &, const QString &, const QByteArray &);
+    bool decodeStarting(QQuickPixmapReply *);
+    void decodeFinished(QQuickPixmapReply *, QQuickPixmapReply::ReadError, const QString &,
+                        const QSize &, const QImage &);
+
     QList<QQuickPixmapReply*> jobs;
     QList<QQuickPixmapReply*> cancelled;
+    QSet<QQuickPixmapReply*> activeDecodes;
+    QThreadPool decodePool;
     QQmlEngine *engine;
     QObject *eventLoopQuitHack;
 
@@ -379,9 +410,26 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
     }
 }
 
+/*
+    Returns the number of threads decoding images for each engine. This defaults to the number
+    of cores and can be changed with the QML_IMAGE_DECODE_THREADS environment variable.
+*/
+static int decodeThreadCount()
+{
+    static int count = 0;
+    if (!count) {
+        bool ok = false;
+        count = qgetenv("QML_IMAGE_DECODE_THREADS").toInt(&ok);
+        if (!ok || count < 1)
+            count = qMax(1, QThread::idealThreadCount());
+    }
+    return count;
+}
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
 : QThread(eng), engine(eng), threadObject(0), accessManager(0)
 {
+    decodePool.setMaxThreadCount(decodeThreadCount());
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
@@ -402,13 +450,19 @@ QQuickPixmapReader::~QQuickPixmapReader()
         delete reply;
     }
     jobs.clear();
-    QList<QQuickPixmapReply*> activeJobs = replies.values();
+    QList<QQuickPixmapReply*> activeJobs = replies.values() + activeDecodes.toList();
     foreach (QQuickPixmapReply *reply, activeJobs) {
         if (reply->loading) {
             cancelled.append(reply);
             reply->data = 0;
         }
     }
+    mutex.unlock();
+
+    // The decoders report back to this object, so let them finish first.
+    decodePool.waitForDone();
+
+    mutex.lock();
     if (threadObject) threadObject->processJobs();
     mutex.unlock();
 
@@ -442,26 +496,15 @@ void QQuickPixmapReader::networkRequestDone(QNetworkReply *reply)
             }
         }
 
-        QImage image;
-        QQuickPixmapReply::ReadError error = QQuickPixmapReply::NoError;
-        QString errorString;
-        QSize readSize;
         if (reply->error()) {
-            error = QQuickPixmapReply::Loading;
-            errorString = reply->errorString();
+            // send completion event to the QQuickPixmapReply
+            mutex.lock();
+            if (!cancelled.contains(job))
+                job->postReply(QQuickPixmapReply::Loading, reply->errorString(), QSize(), 0);
+            mutex.unlock();
         } else {
-            QSystraceEvent trace("graphics", "QQuickPixmapCache::networkRead");
-            QByteArray all = reply->readAll();
-            QBuffer buff(&all);
-            buff.open(QIODevice::ReadOnly);
-            if (!readImage(reply->url(), &buff, &image, &errorString, &readSize, job->requestSize))
-                error = QQuickPixmapReply::Decoding;
-       }
-        // send completion event to the QQuickPixmapReply
-        mutex.lock();
-        if (!cancelled.contains(job))
-            job->postReply(error, errorString, readSize, textureFactoryForImage(image));
-        mutex.unlock();
+            startDecode(job, reply->url(), job->requestSize, QString(), reply->readAll());
+        }
     }
     reply->deleteLater();
 
@@ -500,13 +543,16 @@ void QQuickPixmapReader::processJobs()
     QMutexLocker locker(&mutex);
 
     while (true) {
-        if (cancelled.isEmpty() && (jobs.isEmpty() || replies.count() >= IMAGEREQUEST_MAX_REQUEST_COUNT)) 
-            return; // Nothing else to do
-
         // Clean cancelled jobs
         if (cancelled.count()) {
+            QList<QQuickPixmapReply*> decoding;
             for (int i = 0; i < cancelled.count(); ++i) {
                 QQuickPixmapReply *job = cancelled.at(i);
+                if (activeDecodes.contains(job)) {
+                    // still referenced by a decoder, which processes the jobs again once done
+                    decoding.append(job);
+                    continue;
+                }
                 QNetworkReply *reply = replies.key(job, 0);
                 if (reply && reply->isRunning()) {
                     // cancel any jobs already started
@@ -517,23 +563,51 @@ void QQuickPixmapReader::processJobs()
                 // deleteLater, since not owned by this thread
                 job->deleteLater();
             }
-            cancelled.clear();
+            cancelled = decoding;
         }
 
-        if (!jobs.isEmpty() && replies.count() < IMAGEREQUEST_MAX_REQUEST_COUNT) {
-            QQuickPixmapReply *runningJob = jobs.takeLast();
-            runningJob->loading = true;
+        QQuickPixmapReply *runningJob = takeNextJob();
+        if (!runningJob)
+            return; // Nothing else to do
 
-            QUrl url = runningJob->url;
-            QQmlPixmapProfiler pixmapProfiler;
-            pixmapProfiler.startLoading(url);
+        runningJob->loading = true;
+
+        QUrl url = runningJob->url;
+        QQmlPixmapProfiler pixmapProfiler;
+        pixmapProfiler.startLoading(url);
+
+        QSize requestSize = runningJob->requestSize;
+        locker.unlock();
+        processJob(runningJob, url, requestSize);
+        locker.relock();
+    }
+}
+
+/*
+    Returns the pending job with the highest priority which can be started now, preferring
+    the most recently requested one among jobs of equal priority.
 
-            QSize requestSize = runningJob->requestSize;
-            locker.unlock();
-            processJob(runningJob, url, requestSize);
-            locker.relock();
+    Must be called within the mutex.
+*/
+QQuickPixmapReply *QQuickPixmapReader::takeNextJob()
+{
+    const bool canRequest = replies.count() < IMAGEREQUEST_MAX_REQUEST_COUNT;
+    const bool canDecode = activeDecodes.count() < decodePool.maxThreadCount();
+
+    int next = -1;
+    for (int i = jobs.count() - 1; i >= 0; --i) {
+        QQuickPixmapReply *job = jobs.at(i);
+        if (next != -1 && job->priority <= jobs.at(next)->priority)
+            continue;
+        if (!(canRequest && canDecode) && job->url.scheme() != QLatin1String("image")) {
+            const bool local = !QQmlFile::urlToLocalFileOrQrc(job->url).isEmpty();
+            if (local ? !canDecode : !canRequest)
+                continue;
         }
+        next = i;
     }
+
+    return next != -1 ? jobs.takeAt(next) : 0;
 }
 
 void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &url, 
@@ -601,24 +675,8 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         QString lf = QQmlFile::urlToLocalFileOrQrc(url);
         if (!lf.isEmpty()) {
-            // Image is local - load/decode immediately
-            QSystraceEvent trace("graphics", "QQuickPixmapCache::localRead");
-            QImage image;
-            QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-            QString errorStr;
-            QFile f(lf);
-            QSize readSize;
-            if (f.open(QIODevice::ReadOnly)) {
-                if (!readImage(url, &f, &image, &errorStr, &readSize, requestSize))
-                    errorCode = QQuickPixmapReply::Loading;
-            } else {
-                errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                errorCode = QQuickPixmapReply::Loading;
-            }
-            mutex.lock();
-            if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, textureFactoryForImage(image));
-            mutex.unlock();
+            // Image is local - load/decode on one of the decoding threads
+            startDecode(runningJob, url, requestSize, lf, QByteArray());
         } else {
             // Network resource
             QNetworkRequest req(url);
@@ -634,6 +692,87 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     }
 }
 
+void QQuickPixmapReader::startDecode(QQuickPixmapReply *job, const QUrl &url, const QSize &requestSize,
+                                     const QString &localFile, const QByteArray &data)
+{
+    QMutexLocker locker(&mutex);
+    if (cancelled.contains(job))
+        return;
+    activeDecodes.insert(job);
+    decodePool.start(new QQuickPixmapDecodeJob(this, job, url, requestSize, localFile, data), job->priority);
+}
+
+/*
+    Called by a decoder before it starts working on \a job. Returns false if the job has
+    been cancelled in the meantime, in which case the decoder must not touch it again.
+*/
+bool QQuickPixmapReader::decodeStarting(QQuickPixmapReply *job)
+{
+    QMutexLocker locker(&mutex);
+    if (!cancelled.contains(job))
+        return true;
+
+    activeDecodes.remove(job);
+    if (threadObject) threadObject->processJobs();
+    return false;
+}
+
+void QQuickPixmapReader::decodeFinished(QQuickPixmapReply *job, QQuickPixmapReply::ReadError error,
+                                        const QString &errorString, const QSize &readSize, const QImage &image)
+{
+    QQuickTextureFactory *factory = textureFactoryForImage(image);
+
+    QMutexLocker locker(&mutex);
+    activeDecodes.remove(job);
+    if (!cancelled.contains(job))
+        job->postReply(error, errorString, readSize, factory);
+    else
+        delete factory;
+    // a decoding slot is free again, and cancelled jobs may be waiting for deletion
+    if (threadObject) threadObject->processJobs();
+}
+
+QQuickPixmapDecodeJob::QQuickPixmapDecodeJob(QQuickPixmapReader *reader, QQuickPixmapReply *reply,
+                                             const QUrl &url, const QSize &requestSize,
+                                             const QString &localFile, const QByteArray &data)
+    : m_reader(reader), m_reply(reply), m_url(url), m_requestSize(requestSize)
+    , m_localFile(localFile), m_data(data)
+{
+}
+
+void QQuickPixmapDecodeJob::run()
+{
+    // Decoding should not compete with the GUI and render threads.
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+    if (!m_reader->decodeStarting(m_reply))
+        return;
+
+    QImage image;
+    QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+    if (!m_localFile.isEmpty()) {
+        QSystraceEvent trace("graphics", "QQuickPixmapCache::localRead");
+        QFile f(m_localFile);
+        if (f.open(QIODevice::ReadOnly)) {
+            if (!readImage(m_url, &f, &image, &errorStr, &readSize, m_requestSize))
+                errorCode = QQuickPixmapReply::Loading;
+        } else {
+            errorStr = QQuickPixmap::tr("Cannot open: %1").arg(m_url.toString());
+            errorCode = QQuickPixmapReply::Loading;
+        }
+    } else {
+        QSystraceEvent trace("graphics", "QQuickPixmapCache::networkRead");
+        QBuffer buff(&m_data);
+        buff.open(QIODevice::ReadOnly);
+        if (!readImage(m_url, &buff, &image, &errorStr, &readSize, m_requestSize))
+            errorCode = QQuickPixmapReply::Decoding;
+    }
+
+    m_reader->decodeFinished(m_reply, errorCode, errorStr, readSize, image);
+}
+
 QQuickPixmapReader *QQuickPixmapReader::instance(QQmlEngine *engine)
 {
     // XXX NOTE: must be called within readerMutex locking.
@@ -679,6 +818,13 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     mutex.unlock();
 }
 
+void QQuickPixmapReader::setPriority(QQuickPixmapReply *reply, int priority)
+{
+    mutex.lock();
+    reply->priority = priority;
+    mutex.unlock();
+}
+
 void QQuickPixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -882,7 +1028,8 @@ void QQuickPixmap::purgeCache()
 }
 
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
-: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), loading(false), redirectCount(0)
+: data(d), engineForReader(0), requestSize(d->requestSize), url(d->url), loading(false), redirectCount(0),
+  priority(0)
 {
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
@@ -1287,6 +1434,24 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QSize &reques
     }
 }
 
+/*!
+    Sets the \a priority of the pending request for this pixmap. Requests with a higher
+    priority are loaded first; the default priority is 0.
+
+    This has no effect if the pixmap is not loading asynchronously.
+*/
+void QQuickPixmap::setPriority(int priority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QQuickPixmapReader::readerMutex.lock();
+    QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader);
+    if (reader)
+        reader->setPriority(d->reply, priority);
+    QQuickPixmapReader::readerMutex.unlock();
+}
+
 void QQuickPixmap::clear()
 {
     if (d) {
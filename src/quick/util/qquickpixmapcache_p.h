@@ -113,6 +113,8 @@ public:
     void load(QQmlEngine *, const QUrl &, const QSize &);
     void load(QQmlEngine *, const QUrl &, const QSize &, QQuickPixmap::Options options);
 
+    void setPriority(int priority);
+
     void clear();
     void clear(QObject *);
 
@@ -126,6 +126,7 @@ public:
         SceneGraphWindowsRenderShow,
         SceneGraphWindowsAnimations,
         SceneGraphWindowsPolishFrame,
+        SceneGraphTextureUploadQueue,
 
         MaximumSceneGraphFrameType
     };
@@ -264,6 +265,7 @@ void QQmlProfilerClient::messageReceived(const QByteArray &message)
         stream >> data.detailType;
         qint64 subtime_1, subtime_2, subtime_3, subtime_4, subtime_5;
         int glyphCount;
+        int pendingUploads;
         switch (data.detailType) {
         // RendererFrame: preprocessTime, updateTime, bindingTime, renderTime
         case QQmlProfilerClient::SceneGraphRendererFrame: stream >> subtime_1 >> subtime_2 >> subtime_3 >> subtime_4; break;
@@ -285,6 +287,8 @@ void QQmlProfilerClient::messageReceived(const QByteArray &message)
         case QQmlProfilerClient::SceneGraphWindowsAnimations: stream >> subtime_1; break;
             // WindowsRenderWindow: polish time
         case QQmlProfilerClient::SceneGraphWindowsPolishFrame: stream >> subtime_1; break;
+            // TextureUploadQueue: pendingUploads, uploadedBytes
+        case QQmlProfilerClient::SceneGraphTextureUploadQueue: stream >> pendingUploads >> subtime_2; break;
         }
         break;
     }
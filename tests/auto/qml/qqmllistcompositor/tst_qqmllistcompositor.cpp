@@ -152,6 +152,7 @@ private slots:
     void find();
     void findInsertPosition_data();
     void findInsertPosition();
+    void findFragmented();
     void insert();
     void clearFlags_data();
     void clearFlags();
@@ -294,6 +295,62 @@ void tst_qqmllistcompositor::findInsertPosition()
     QCOMPARE(it->index, rangeIndex);
 }
 
+void tst_qqmllistcompositor::findFragmented()
+{
+    // Every item is in its own range so lookups far from the last found item use the index.
+    int listA; void *a = &listA;
+    const int count = 4096;
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+    compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+
+    for (int i = 0; i < count; ++i) {
+        int flags = C::DefaultFlag;
+        if (i % 2 == 0)
+            flags |= VisibleFlag;
+        if (i % 3 == 0)
+            flags |= SelectionFlag;
+        compositor.append(a, i, 1, flags);
+    }
+
+    QCOMPARE(compositor.count(C::Default), count);
+    QCOMPARE(compositor.count(Visible), (count + 1) / 2);
+    QCOMPARE(compositor.count(Selection), (count + 2) / 3);
+
+    for (int i = 0, d = 0; i < 1024; ++i, d = (d + 1031) % count) {
+        if (i % 64 == 63) {
+            // Invalidate the index.
+            const int m = 3 * (d / 6) + 1;
+            compositor.setFlags(C::Default, m, 1, SelectionFlag);
+            compositor.clearFlags(C::Default, m, 1, SelectionFlag);
+        }
+
+        C::iterator it = compositor.find(C::Default, d);
+        QCOMPARE(it.modelIndex(), d);
+        QCOMPARE(it.index[C::Default], d);
+        QCOMPARE(it.index[Visible], (d + 1) / 2);
+        QCOMPARE(it.index[Selection], (d + 2) / 3);
+
+        C::insert_iterator insertIt = compositor.findInsertPosition(C::Default, count - d);
+        QCOMPARE(insertIt.index[C::Default], count - d);
+        QCOMPARE(insertIt.index[Visible], (count - d + 1) / 2);
+        QCOMPARE(insertIt.index[Selection], (count - d + 2) / 3);
+
+        const int v = (d * 7) % compositor.count(Visible);
+        it = compositor.find(Visible, v);
+        QCOMPARE(it.modelIndex(), 2 * v);
+        QCOMPARE(it.index[C::Default], 2 * v);
+        QCOMPARE(it.index[Selection], (2 * v + 2) / 3);
+
+        const int s = (d * 13) % compositor.count(Selection);
+        it = compositor.find(Selection, s);
+        QCOMPARE(it.modelIndex(), 3 * s);
+        QCOMPARE(it.index[C::Default], 3 * s);
+        QCOMPARE(it.index[Visible], (3 * s + 1) / 2);
+    }
+}
+
 void tst_qqmllistcompositor::insert()
 {
     QQmlListCompositor compositor;
@@ -130,6 +130,14 @@ private slots:
     void empty_element_warning_data();
     void datetime();
     void datetime_data();
+    void repeated_strings();
+    void repeated_strings_shared();
+    void setRows_data();
+    void setRows();
+    void replaceRange_data();
+    void replaceRange();
+    void revisions_data();
+    void revisions();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1255,6 +1263,186 @@ void tst_qqmllistmodel::datetime()
     QVERIFY(expected == dtResult);
 }
 
+void tst_qqmllistmodel::repeated_strings()
+{
+    // Equal strings stored in different elements share their data, changing one mustn't affect the others.
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    QQmlExpression e(engine.rootContext(), &model,
+            "{ for (var i = 0; i < 100; ++i) append({ 'name': 'item', 'group': i % 2 ? 'odd' : 'even' });"
+            "  set(1, { 'name': 'changed' }); get(2).group = 'other'; setProperty(3, 'name', 'set'); }");
+    e.evaluate();
+    QVERIFY(!e.hasError());
+
+    QCOMPARE(model.count(), 100);
+    const int nameRole = model.roleNames().key("name");
+    const int groupRole = model.roleNames().key("group");
+    for (int i = 0; i < 100; ++i) {
+        const QString name = i == 1 ? QStringLiteral("changed") : i == 3 ? QStringLiteral("set") : QStringLiteral("item");
+        const QString group = i == 2 ? QStringLiteral("other") : i % 2 ? QStringLiteral("odd") : QStringLiteral("even");
+        QCOMPARE(model.data(i, nameRole).toString(), name);
+        QCOMPARE(model.data(i, groupRole).toString(), group);
+    }
+}
+
+void tst_qqmllistmodel::repeated_strings_shared()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    // The strings are built at run time, so that each element is given a string of its own.
+    QQmlExpression append(engine.rootContext(), &model,
+            "{ for (var i = 0; i < 10; ++i) append({ 'group': ['gr', 'oup'].join('') }); }");
+    append.evaluate();
+    QVERIFY(!append.hasError());
+    QCOMPARE(model.count(), 10);
+
+    const int groupRole = model.roleNames().key("group");
+    QString first = model.data(0, groupRole).toString();
+    QCOMPARE(first, QStringLiteral("group"));
+    for (int i = 1; i < 10; ++i) {
+        QString value = model.data(i, groupRole).toString();
+        QCOMPARE(value, first);
+        QVERIFY(value.data_ptr() == first.data_ptr());
+    }
+
+    // Clearing the model empties the pool, later strings aren't shared with the old ones.
+    QQmlExpression clear(engine.rootContext(), &model,
+            "{ clear(); append({ 'group': ['gr', 'oup'].join('') }); }");
+    clear.evaluate();
+    QVERIFY(!clear.hasError());
+    QCOMPARE(model.count(), 1);
+    QString value = model.data(0, groupRole).toString();
+    QCOMPARE(value, first);
+    QVERIFY(value.data_ptr() != first.data_ptr());
+}
+
+void tst_qqmllistmodel::setRows_data()
+{
+    QTest::addColumn<bool>("dynamicRoles");
+
+    QTest::newRow("static roles") << false;
+    QTest::newRow("dynamic roles") << true;
+}
+
+void tst_qqmllistmodel::setRows()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("for (var i = 0; i < 10; ++i) model.append({ name: 'item' + i, cost: i, size: i })");
+
+    QSignalSpy spy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    // Only rows and roles which changed are reported.
+    RUNEXPR("model.setRows(2, [{ cost: 2 }, { cost: 30 }, { cost: 4 }, { cost: 50, name: 'changed' }, { cost: 6 }])");
+    QCOMPARE(spy.count(), 1);
+    QList<QVariant> arguments = spy.takeFirst();
+    QCOMPARE(arguments.at(0).value<QModelIndex>(), model.index(3, 0, QModelIndex()));
+    QCOMPARE(arguments.at(1).value<QModelIndex>(), model.index(5, 0, QModelIndex()));
+    QVector<int> roles = arguments.at(2).value<QVector<int> >();
+    QCOMPARE(roles.count(), 2);
+    QVERIFY(roles.contains(roleFromName(&model, "cost")));
+    QVERIFY(roles.contains(roleFromName(&model, "name")));
+
+    QCOMPARE(RUNEXPR("model.get(3).cost").toInt(), 30);
+    QCOMPARE(RUNEXPR("model.get(5).cost").toInt(), 50);
+    QCOMPARE(RUNEXPR("model.get(5).name").toString(), QStringLiteral("changed"));
+    QCOMPARE(RUNEXPR("model.get(4).name").toString(), QStringLiteral("item4"));
+
+    // Properties not in the role list are ignored.
+    RUNEXPR("model.setRows(0, [{ cost: 10, size: 10 }, { cost: 11, size: 11 }], ['size'])");
+    QCOMPARE(spy.count(), 1);
+    arguments = spy.takeFirst();
+    QCOMPARE(arguments.at(0).value<QModelIndex>(), model.index(0, 0, QModelIndex()));
+    QCOMPARE(arguments.at(1).value<QModelIndex>(), model.index(1, 0, QModelIndex()));
+    QCOMPARE(arguments.at(2).value<QVector<int> >(), QVector<int>() << roleFromName(&model, "size"));
+    QCOMPARE(RUNEXPR("model.get(1).cost").toInt(), 1);
+    QCOMPARE(RUNEXPR("model.get(1).size").toInt(), 11);
+
+    // Nothing changed.
+    RUNEXPR("model.setRows(0, [{ cost: 0 }])");
+    QCOMPARE(spy.count(), 0);
+
+    QTest::ignoreMessage(QtWarningMsg, "<Unknown File>: QML ListModel: setRows: indices [8 - 11] out of range [0 - 10]");
+    RUNEXPR("model.setRows(8, [{}, {}, {}])");
+    QCOMPARE(spy.count(), 0);
+}
+
+void tst_qqmllistmodel::replaceRange_data()
+{
+    setRows_data();
+}
+
+void tst_qqmllistmodel::replaceRange()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextProperty("model", &model);
+
+    RUNEXPR("for (var i = 0; i < 10; ++i) model.append({ value: i })");
+
+    QSignalSpy removeSpy(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy insertSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    RUNEXPR("model.replaceRange(2, 5, [{ value: 20 }, { value: 30 }, { value: 40 }])");
+    QCOMPARE(model.count(), 8);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(removeSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(removeSpy.at(0).at(2).toInt(), 6);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(insertSpy.at(0).at(2).toInt(), 4);
+
+    const int values[] = { 0, 1, 20, 30, 40, 7, 8, 9 };
+    for (int i = 0; i < 8; ++i)
+        QCOMPARE(RUNEXPR(QString("model.get(%1).value").arg(i)).toInt(), values[i]);
+}
+
+void tst_qqmllistmodel::revisions_data()
+{
+    QTest::addColumn<QString>("import");
+    QTest::addColumn<QString>("type");
+
+    QTest::newRow("QtQuick 2.0") << "import QtQuick 2.0" << "undefined";
+    QTest::newRow("QtQuick 2.3") << "import QtQuick 2.3" << "function";
+    QTest::newRow("QtQml.Models 2.1") << "import QtQml.Models 2.1" << "undefined";
+    QTest::newRow("QtQml.Models 2.3") << "import QtQml.Models 2.3" << "function";
+}
+
+void tst_qqmllistmodel::revisions()
+{
+    QFETCH(QString, import);
+    QFETCH(QString, type);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData((import + "\nListModel {\n"
+                       "    id: model\n"
+                       "    property string setRowsType: typeof model.setRows\n"
+                       "    property string replaceRangeType: typeof model.replaceRange\n"
+                       "}\n").toUtf8(), QUrl::fromLocalFile(QString("dummy.qml")));
+    QScopedPointer<QObject> model(component.create());
+    QVERIFY2(model, qPrintable(component.errorString()));
+
+    QCOMPARE(model->property("setRowsType").toString(), type);
+    QCOMPARE(model->property("replaceRangeType").toString(), type);
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
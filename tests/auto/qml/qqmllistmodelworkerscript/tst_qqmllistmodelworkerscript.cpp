@@ -111,6 +111,8 @@ private slots:
     void property_changes_worker_data();
     void worker_sync_data();
     void worker_sync();
+    void worker_sync_changes_data();
+    void worker_sync_changes();
     void worker_remove_element_data();
     void worker_remove_element();
     void worker_remove_list_data();
@@ -704,6 +706,59 @@ void tst_qqmllistmodelworkerscript::worker_sync()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_changes_data()
+{
+    worker_sync_data();
+}
+
+void tst_qqmllistmodelworkerscript::worker_sync_changes()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    RUNEVAL(item, "for (var i = 0; i < 6; ++i) model.append({ value: i, name: 'n' + i })");
+
+    const int valueRole = roleFromName(&model, "value");
+    const int nameRole = roleFromName(&model, "name");
+
+    // Changes, removals, moves and insertions are all applied by the next sync.
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, QStringList()
+            << "setProperty(1, 'value', 10)"
+            << "remove(3)"
+            << "move(0, 4, 1)"
+            << "append({ value: 6, name: 'n6' })")));
+    waitForWorker(item);
+
+    const int values[] = { 10, 2, 4, 5, 0, 6 };
+    const char *names[] = { "n1", "n2", "n4", "n5", "n0", "n6" };
+    QCOMPARE(model.count(), 6);
+    for (int i = 0; i < 6; ++i) {
+        QCOMPARE(model.data(i, valueRole).toInt(), values[i]);
+        QCOMPARE(model.data(i, nameRole).toString(), QString(names[i]));
+    }
+
+    QSignalSpy spy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker", Q_ARG(QVariant, QStringList()
+            << "setProperty(2, 'value', 40)")));
+    waitForWorker(item);
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<QModelIndex>(), model.index(2, 0, QModelIndex()));
+    QCOMPARE(model.data(2, valueRole).toInt(), 40);
+    QCOMPARE(model.data(1, valueRole).toInt(), 2);
+    QCOMPARE(model.data(3, valueRole).toInt(), 5);
+
+    delete item;
+    qApp->processEvents();
+}
+
 void tst_qqmllistmodelworkerscript::worker_remove_element_data()
 {
     worker_sync_data();
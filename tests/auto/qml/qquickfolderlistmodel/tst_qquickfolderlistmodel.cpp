@@ -44,6 +44,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtCore/qabstractitemmodel.h>
 #include <QDebug>
 #include "../../shared/util.h"
@@ -55,6 +56,7 @@
 // From qquickfolderlistmodel.h
 const int FileNameRole = Qt::UserRole+1;
 const int FilePathRole = Qt::UserRole+2;
+const int FileSizeRole = Qt::UserRole+5;
 enum SortField { Unsorted, Name, Time, Size, Type };
 
 class tst_qquickfolderlistmodel : public QQmlDataTest
@@ -82,6 +84,10 @@ private slots:
     void showDotAndDotDot();
     void showDotAndDotDot_data();
     void sortReversed();
+#ifndef QT_NO_FILESYSTEMWATCHER
+    void updateFolder();
+    void updateFileSize();
+#endif
 
 private:
     void checkNoErrors(const QQmlComponent& component);
@@ -341,6 +347,95 @@ void tst_qquickfolderlistmodel::sortReversed()
     QCOMPARE(flm->data(flm->index(0),FileNameRole).toString(), QLatin1String("sortReversed.qml"));
 }
 
+#ifndef QT_NO_FILESYSTEMWATCHER
+static bool createFile(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly);
+}
+
+void tst_qquickfolderlistmodel::updateFolder()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QDir dir(tempDir.path());
+    QVERIFY(createFile(dir.filePath("a.qml")));
+    QVERIFY(createFile(dir.filePath("c.qml")));
+
+    QQmlComponent component(&engine, testFileUrl("basic.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), 2); // wait for refresh
+
+    QSignalSpy resetSpy(flm, SIGNAL(modelReset()));
+    QSignalSpy insertedSpy(flm, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+    // Only the new file is inserted, in its sorted position.
+    QVERIFY(createFile(dir.filePath("b.qml")));
+    QTRY_COMPARE(flm->property("count").toInt(), 3);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 1);
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole).toString(), QLatin1String("a.qml"));
+    QCOMPARE(flm->data(flm->index(1), FileNameRole).toString(), QLatin1String("b.qml"));
+    QCOMPARE(flm->data(flm->index(2), FileNameRole).toString(), QLatin1String("c.qml"));
+
+    // Only the deleted file is removed.
+    insertedSpy.clear();
+    QVERIFY(QFile::remove(dir.filePath("a.qml")));
+    QTRY_COMPARE(flm->property("count").toInt(), 2);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(insertedSpy.count(), 0);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole).toString(), QLatin1String("b.qml"));
+    QCOMPARE(flm->data(flm->index(1), FileNameRole).toString(), QLatin1String("c.qml"));
+
+    QCOMPARE(resetSpy.count(), 0);
+    delete flm;
+}
+
+void tst_qquickfolderlistmodel::updateFileSize()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QDir dir(tempDir.path());
+    QFile file(dir.filePath("a.qml"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write("12345"), qint64(5));
+    file.close();
+
+    QQmlComponent component(&engine, testFileUrl("basic.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    // The size is read with the listing, it is never a placeholder.
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), 1);
+    QCOMPARE(flm->data(flm->index(0), FileSizeRole).toLongLong(), qint64(5));
+
+    // A change of size is reported for the row, which stays in place.
+    QSignalSpy changedSpy(flm, SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QVERIFY(file.open(QIODevice::Append));
+    QCOMPARE(file.write("67890"), qint64(5));
+    file.close();
+    QVERIFY(createFile(dir.filePath("b.qml")));
+    QTRY_COMPARE(flm->property("count").toInt(), 2);
+    QTRY_COMPARE(flm->data(flm->index(0), FileSizeRole).toLongLong(), qint64(10));
+    QVERIFY(!changedSpy.isEmpty());
+    QCOMPARE(removedSpy.count(), 0);
+
+    delete flm;
+}
+#endif
+
 QTEST_MAIN(tst_qquickfolderlistmodel)
 
 #include "tst_qquickfolderlistmodel.moc"
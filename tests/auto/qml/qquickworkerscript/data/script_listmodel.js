@@ -0,0 +1,3 @@
+WorkerScript.onMessage = function(model) {
+    WorkerScript.sendMessage(model === undefined ? -1 : model.count)
+}
@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+Item {
+    ListModel {
+        id: listModel
+        ListElement { name: "a" }
+        ListElement { name: "b" }
+    }
+
+    BaseWorker {
+        id: first
+        objectName: "first"
+        source: "script_listmodel.js"
+    }
+
+    BaseWorker {
+        id: second
+        objectName: "second"
+        source: "script_listmodel.js"
+    }
+
+    function sendToFirst() { first.sendMessage(listModel) }
+    function sendToSecond() { second.sendMessage(listModel) }
+}
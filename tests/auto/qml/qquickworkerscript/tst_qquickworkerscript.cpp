@@ -56,7 +56,7 @@ class tst_QQuickWorkerScript : public QQmlDataTest
 {
     Q_OBJECT
 public:
-    tst_QQuickWorkerScript() {}
+    tst_QQuickWorkerScript() { qputenv("QML_WORKERSCRIPT_THREADS", "2"); }
 private slots:
     void source();
     void messaging();
@@ -72,6 +72,8 @@ private slots:
     void script_var();
     void script_global();
     void stressDispose();
+    void threadPool();
+    void listModelThreads();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -140,6 +142,17 @@ void tst_QQuickWorkerScript::messaging_data()
     QTest::newRow("string") << qVariantFromValue(QString("More cheeeese, Gromit!"));
     QTest::newRow("variant list") << qVariantFromValue((QVariantList() << "a" << "b" << "c"));
     QTest::newRow("date time") << qVariantFromValue(QDateTime::currentDateTime());
+    QTest::newRow("number list") << qVariantFromValue((QVariantList() << 1 << 2.5 << -3 << 1e10));
+    QTest::newRow("out of int range number list")
+            << qVariantFromValue((QVariantList() << 1 << -2147483649.0 << 2147483648.0 << qInf() << -qInf()));
+    QTest::newRow("repeated strings") << qVariantFromValue((QVariantList() << "a" << "b" << "a" << "a"));
+    QVariantMap first;
+    first.insert("name", "first");
+    first.insert("cost", 1);
+    QVariantMap second;
+    second.insert("name", "second");
+    second.insert("cost", 2.5);
+    QTest::newRow("map list") << qVariantFromValue((QVariantList() << first << second << first));
 #ifndef QT_NO_REGEXP
     // Qt Script's QScriptValue -> QRegExp uses RegExp2 pattern syntax
     QTest::newRow("regexp") << qVariantFromValue(QRegExp("^\\d\\d?$", Qt::CaseInsensitive, QRegExp::RegExp2));
@@ -377,6 +390,59 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::threadPool()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("worker.qml"));
+
+    QScopedPointer<QQuickWorkerScript> workers[3];
+    for (int i = 0; i < 3; ++i) {
+        workers[i].reset(qobject_cast<QQuickWorkerScript*>(component.create()));
+        QVERIFY(workers[i]);
+    }
+
+    // Workers are spread over two threads.
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.count(), 2);
+
+    for (int i = 0; i < 3; ++i) {
+        const QMetaObject *mo = workers[i]->metaObject();
+        QVariant value(i);
+        QVERIFY(QMetaObject::invokeMethod(workers[i].data(), "testSend", Q_ARG(QVariant, value)));
+        waitForEchoMessage(workers[i].data());
+        QCOMPARE(mo->property(mo->indexOfProperty("response")).read(workers[i].data()).value<QVariant>(), value);
+    }
+
+    for (int i = 0; i < 3; ++i)
+        workers[i].reset();
+    qApp->processEvents();
+}
+
+void tst_QQuickWorkerScript::listModelThreads()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("worker_listmodel.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY(root);
+
+    QQuickWorkerScript *first = root->findChild<QQuickWorkerScript *>("first");
+    QQuickWorkerScript *second = root->findChild<QQuickWorkerScript *>("second");
+    QVERIFY(first && second);
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.count(), 2);
+
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendToFirst"));
+    waitForEchoMessage(first);
+    QCOMPARE(first->property("response").toInt(), 2);
+
+    // The model is bound to the thread of the first worker.
+    QTest::ignoreMessage(QtWarningMsg, "ListModel: a model can only be passed to WorkerScripts running on one thread");
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendToSecond"));
+    waitForEchoMessage(second);
+    QCOMPARE(second->property("response").toInt(), -1);
+
+    root.reset();
+    qApp->processEvents();
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
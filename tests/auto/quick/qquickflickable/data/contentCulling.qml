@@ -0,0 +1,26 @@
+import QtQuick 2.3
+
+Flickable {
+    width: 200
+    height: 200
+    clip: true
+    cullsContent: true
+    contentWidth: 200
+    contentHeight: column.height
+
+    Column {
+        id: column
+        objectName: "column"
+        width: parent.width
+
+        Repeater {
+            model: 50
+            Rectangle {
+                objectName: "rect" + index
+                width: 200
+                height: 50
+                color: index % 2 ? "red" : "blue"
+            }
+        }
+    }
+}
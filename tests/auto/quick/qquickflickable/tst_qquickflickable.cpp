@@ -98,6 +98,7 @@ private slots:
     void stopAtBounds_data();
     void nestedMouseAreaUsingTouch();
     void pressDelayWithLoader();
+    void contentCulling();
 
 private:
     void flickWithTouch(QQuickWindow *window, QTouchDevice *touchDevice, const QPoint &from, const QPoint &to);
@@ -1596,6 +1597,57 @@ void tst_qquickflickable::pressDelayWithLoader()
     QTest::mouseRelease(window.data(), Qt::LeftButton, 0, QPoint(150, 150));
 }
 
+void tst_qquickflickable::contentCulling()
+{
+    QScopedPointer<QQuickView> window(new QQuickView);
+    window->setSource(testFileUrl("contentCulling.qml"));
+    QTRY_COMPARE(window->status(), QQuickView::Ready);
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickFlickable *flickable = qobject_cast<QQuickFlickable *>(window->rootObject());
+    QVERIFY(flickable != 0);
+    QVERIFY(flickable->cullsContent());
+    QVERIFY(!QQuickFlickable().cullsContent());
+
+    QQuickItem *column = findItem<QQuickItem>(flickable, "column");
+    QQuickItem *first = findItem<QQuickItem>(flickable, "rect0");
+    QQuickItem *visible = findItem<QQuickItem>(flickable, "rect3");
+    QQuickItem *last = findItem<QQuickItem>(flickable, "rect49");
+    QVERIFY(first && visible && last);
+
+    QTRY_VERIFY(QQuickItemPrivate::get(last)->viewportCulled);
+    QVERIFY(!QQuickItemPrivate::get(first)->viewportCulled);
+    QVERIFY(!QQuickItemPrivate::get(visible)->viewportCulled);
+
+    flickable->setContentY(flickable->contentHeight() - flickable->height());
+    QTRY_VERIFY(QQuickItemPrivate::get(first)->viewportCulled);
+    QVERIFY(!QQuickItemPrivate::get(last)->viewportCulled);
+    QVERIFY(QQuickItemPrivate::get(visible)->viewportCulled);
+
+    // Partially visible items are not culled.
+    flickable->setContentY(25);
+    QTRY_VERIFY(!QQuickItemPrivate::get(first)->viewportCulled);
+    QVERIFY(!QQuickItemPrivate::get(visible)->viewportCulled);
+    QVERIFY(QQuickItemPrivate::get(last)->viewportCulled);
+
+    // Moving the item containing culled items brings them into view.
+    QVERIFY(column != 0);
+    column->setY(flickable->contentY() - last->y());
+    QTRY_VERIFY(!QQuickItemPrivate::get(last)->viewportCulled);
+    QVERIFY(QQuickItemPrivate::get(first)->viewportCulled);
+
+    // Turning culling off shows the content again.
+    flickable->setCullsContent(false);
+    QVERIFY(!QQuickItemPrivate::get(first)->viewportCulled);
+    flickable->setCullsContent(true);
+    QTRY_VERIFY(QQuickItemPrivate::get(first)->viewportCulled);
+
+    // Culled items are shown again when the flickable leaves the window.
+    flickable->setParentItem(0);
+    QVERIFY(!QQuickItemPrivate::get(first)->viewportCulled);
+}
+
 QTEST_MAIN(tst_qquickflickable)
 
 #include "tst_qquickflickable.moc"
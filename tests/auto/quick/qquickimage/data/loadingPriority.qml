@@ -0,0 +1,18 @@
+import QtQuick 2.0
+
+Item {
+    width: 200
+    height: 200
+
+    Image { objectName: "shown"; asynchronous: true; source: "image://ordered/shown" }
+    Image { objectName: "unculled"; asynchronous: true; source: "image://ordered/unculled" }
+    Image { objectName: "culled"; asynchronous: true; source: "image://ordered/culled" }
+    Item {
+        objectName: "culledParent"
+        Image { objectName: "culledChild"; asynchronous: true; source: "image://ordered/culledChild" }
+    }
+    Item {
+        objectName: "effectParent"
+        Image { objectName: "effectChild"; asynchronous: true; source: "image://ordered/effectChild" }
+    }
+}
@@ -49,12 +49,15 @@
 #include <QtQuick/qquickview.h>
 #include <private/qquickimage_p.h>
 #include <private/qquickimagebase_p.h>
+#include <private/qquickitem_p.h>
 #include <private/qquickloader_p.h>
 #include <QtQml/qqmlcontext.h>
 #include <QtQml/qqmlexpression.h>
 #include <QtTest/QSignalSpy>
 #include <QtGui/QPainter>
 #include <QtGui/QImageReader>
+#include <QtCore/QMutex>
+#include <QtCore/QSemaphore>
 #include <QQuickWindow>
 #include <QQuickImageProvider>
 
@@ -105,6 +108,7 @@ private slots:
     void progressAndStatusChanges();
     void sourceSizeChanges();
     void correctStatus();
+    void loadingPriority();
 
 private:
     QQmlEngine engine;
@@ -928,6 +932,91 @@ void tst_qquickimage::correctStatus()
     delete obj;
 }
 
+class OrderedImageProvider : public QQuickImageProvider
+{
+public:
+    OrderedImageProvider() : QQuickImageProvider(Image) {}
+
+    QImage requestImage(const QString &id, QSize *size, const QSize& requestedSize)
+    {
+        Q_UNUSED(requestedSize);
+        if (id == QLatin1String("gate")) {
+            // Block the reader until all the other requests are queued
+            gateEntered.release();
+            gate.tryAcquire(1, 10000);
+        } else {
+            QMutexLocker locker(&mutex);
+            requests.append(id);
+        }
+
+        QImage image(10, 10, QImage::Format_RGB32);
+        image.fill(QColor("green").rgb());
+        if (size)
+            *size = image.size();
+        return image;
+    }
+
+    QStringList takeRequests()
+    {
+        QMutexLocker locker(&mutex);
+        QStringList result = requests;
+        requests.clear();
+        return result;
+    }
+
+    QSemaphore gateEntered;
+    QSemaphore gate;
+
+private:
+    QMutex mutex;
+    QStringList requests;
+};
+
+void tst_qquickimage::loadingPriority()
+{
+    QQmlEngine engine;
+    OrderedImageProvider *provider = new OrderedImageProvider;
+    engine.addImageProvider(QLatin1String("ordered"), provider);
+
+    QQmlComponent gateComponent(&engine);
+    gateComponent.setData("import QtQuick 2.0\nImage { asynchronous: true; source: \"image://ordered/gate\" }", QUrl::fromLocalFile(""));
+    QScopedPointer<QObject> gateImage(gateComponent.create());
+    QVERIFY(gateImage);
+    QVERIFY(provider->gateEntered.tryAcquire(1, 5000));
+
+    QQmlComponent component(&engine, testFileUrl("loadingPriority.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY(root);
+
+    QQuickItem *culled = root->findChild<QQuickItem *>("culled");
+    QQuickItem *unculled = root->findChild<QQuickItem *>("unculled");
+    QQuickItem *culledParent = root->findChild<QQuickItem *>("culledParent");
+    QQuickItem *effectParent = root->findChild<QQuickItem *>("effectParent");
+    QVERIFY(culled && unculled && culledParent && effectParent);
+
+    // Hide some of the images while their requests are still queued
+    QQuickItemPrivate::get(culled)->setCulled(true);
+    QQuickItemPrivate::get(culledParent)->setCulled(true);
+    QQuickItemPrivate::get(effectParent)->refFromEffectItem(true);
+    QQuickItemPrivate::get(unculled)->setCulled(true);
+    QQuickItemPrivate::get(unculled)->setCulled(false);
+
+    provider->gate.release();
+
+    QList<QQuickImageBase *> images = root->findChildren<QQuickImageBase *>();
+    QCOMPARE(images.count(), 5);
+    foreach (QQuickImageBase *image, images)
+        QTRY_COMPARE(image->status(), QQuickImageBase::Ready);
+
+    // Shown images are requested before the hidden ones, although they were requested earlier
+    QStringList requests = provider->takeRequests();
+    QCOMPARE(requests.count(), 5);
+    QCOMPARE(requests.mid(0, 2).toSet(), QSet<QString>() << "shown" << "unculled");
+    QCOMPARE(requests.mid(2).toSet(), QSet<QString>() << "culled" << "culledChild" << "effectChild");
+
+    QQuickItemPrivate::get(effectParent)->derefFromEffectItem(true);
+}
+
 QTEST_MAIN(tst_qquickimage)
 
 #include "tst_qquickimage.moc"
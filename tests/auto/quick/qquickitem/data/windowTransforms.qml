@@ -0,0 +1,27 @@
+import QtQuick 2.0
+
+Item {
+    Item {
+        objectName: "a"
+        x: 10; y: 20
+        width: 100; height: 100
+        transform: Translate { objectName: "translate" }
+
+        Item {
+            objectName: "b"
+            x: 5; y: 5
+            width: 50; height: 50
+
+            Item {
+                objectName: "c"
+                x: 1; y: 2
+                width: 10; height: 10
+            }
+        }
+    }
+
+    Item {
+        objectName: "other"
+        x: 200; y: 300
+    }
+}
@@ -44,6 +44,8 @@
 #include <QtQuick/qquickitem.h>
 #include <QtQuick/qquickwindow.h>
 #include <QtQuick/qquickview.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
 #include "private/qquickfocusscope_p.h"
 #include "private/qquickitem_p.h"
 #include <qpa/qwindowsysteminterface.h>
@@ -168,6 +170,8 @@ private slots:
 
     void acceptedMouseButtons();
 
+    void windowTransforms();
+
 private:
 
     enum PaintOrderOp {
@@ -1758,6 +1762,81 @@ void tst_qquickitem::acceptedMouseButtons()
     QCOMPARE(item.releaseCount, 3);
 }
 
+// The transform of item computed from all its ancestors, without the cached transforms
+static QTransform uncachedItemToWindowTransform(QQuickItem *item)
+{
+    QList<QQuickItem *> ancestors;
+    for (QQuickItem *i = item; i; i = i->parentItem())
+        ancestors.prepend(i);
+
+    QTransform transform;
+    foreach (QQuickItem *i, ancestors)
+        QQuickItemPrivate::get(i)->itemToParentTransform(transform);
+    return transform;
+}
+
+#define COMPARE_WINDOW_TRANSFORMS(item) \
+    do { \
+        const QTransform transform = uncachedItemToWindowTransform(item); \
+        QCOMPARE(item->mapToScene(QPointF(3, 4)), transform.map(QPointF(3, 4))); \
+        QCOMPARE(item->mapFromScene(QPointF(30, 40)), transform.inverted().map(QPointF(30, 40))); \
+    } while (false)
+
+void tst_qquickitem::windowTransforms()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("windowTransforms.qml"));
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(root);
+
+    QQuickItem *a = root->findChild<QQuickItem *>("a");
+    QQuickItem *b = root->findChild<QQuickItem *>("b");
+    QQuickItem *c = root->findChild<QQuickItem *>("c");
+    QQuickItem *other = root->findChild<QQuickItem *>("other");
+    QObject *translate = root->findChild<QObject *>("translate");
+    QVERIFY(a && b && c && other && translate);
+
+    COMPARE_WINDOW_TRANSFORMS(c);
+    QCOMPARE(c->mapToScene(QPointF(3, 4)), QPointF(19, 31));
+
+    // Each change of an ancestor invalidates the cached transforms of c
+    a->setX(30);
+    COMPARE_WINDOW_TRANSFORMS(c);
+    QCOMPARE(c->mapToScene(QPointF(3, 4)), QPointF(39, 31));
+
+    a->setScale(2);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    // The transform origin of a scaled item moves with its size
+    a->setWidth(200);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    b->setRotation(90);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    b->setTransformOrigin(QQuickItem::TopLeft);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    b->setHeight(20);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    translate->setProperty("x", 7);
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    c->setPosition(QPointF(6, 8));
+    COMPARE_WINDOW_TRANSFORMS(c);
+
+    // Moving to another parent, and changes to the old parent no longer apply
+    c->setParentItem(other);
+    COMPARE_WINDOW_TRANSFORMS(c);
+    QCOMPARE(c->mapToScene(QPointF(3, 4)), QPointF(209, 312));
+
+    a->setY(-50);
+    other->setX(100);
+    COMPARE_WINDOW_TRANSFORMS(c);
+    QCOMPARE(c->mapToScene(QPointF(3, 4)), QPointF(109, 312));
+    COMPARE_WINDOW_TRANSFORMS(b);
+}
 
 QTEST_MAIN(tst_qquickitem)
 
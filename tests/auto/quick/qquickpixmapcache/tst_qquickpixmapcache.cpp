@@ -75,6 +75,7 @@ private slots:
 #endif
     void lockingCrash();
     void uncached();
+    void parallelDecode();
 #if PIXMAP_DATA_LEAK_TEST
     void dataLeak();
 #endif
@@ -474,6 +475,33 @@ void tst_qquickpixmapcache::uncached()
 }
 
 
+void tst_qquickpixmapcache::parallelDecode()
+{
+    QQmlEngine engine;
+
+    QList<QQuickPixmap *> pixmaps;
+    for (int i = 0; i < 60; ++i) {
+        QQuickPixmap *pixmap = new QQuickPixmap;
+        pixmap->load(&engine, testFileUrl("exists.png"), QSize(i + 1, i + 1), QQuickPixmap::Asynchronous);
+        QVERIFY(pixmap->isLoading());
+        pixmap->setPriority(i % 3);
+        pixmaps.append(pixmap);
+    }
+
+    // Cancel every other request, whether it is still pending or being decoded
+    for (int i = 0; i < pixmaps.count(); i += 2) {
+        delete pixmaps.at(i);
+        pixmaps[i] = 0;
+    }
+
+    for (int i = 1; i < pixmaps.count(); i += 2) {
+        QTRY_VERIFY(pixmaps.at(i)->isReady());
+        QVERIFY(pixmaps.at(i)->width() <= i + 1);
+    }
+
+    qDeleteAll(pixmaps);
+}
+
 #if PIXMAP_DATA_LEAK_TEST
 // This test should not be enabled by default as it
 // produces spurious output in the expected case.
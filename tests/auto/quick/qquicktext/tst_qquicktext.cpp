@@ -48,6 +48,8 @@
 #include <private/qquicktext_p_p.h>
 #include <private/qquickvaluetypes_p.h>
 #include <QFontMetrics>
+#include <QFontDatabase>
+#include <QThreadPool>
 #include <qmath.h>
 #include <QtQuick/QQuickView>
 #include <private/qguiapplication_p.h>
@@ -154,6 +156,10 @@ private slots:
 
     void hover();
 
+    void asynchronousLayout_data();
+    void asynchronousLayout();
+    void asynchronousLayoutCleared();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -3790,6 +3796,100 @@ void tst_qquicktext::hover()
     QVERIFY(mouseArea->property("wasHovered").toBool());
 }
 
+void tst_qquicktext::asynchronousLayout_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QString>("newText");
+    QTest::addColumn<QString>("properties");
+
+    const QString plain = "Lorem ipsum dolor sit amet\\nconsectetur adipiscing elit";
+    const QString plainLines = "Lorem\\nipsum\\ndolor\\nsit\\namet\\nconsectetur\\nadipiscing\\nelit";
+    const QString styled = "<b>Lorem</b> ipsum <i>dolor</i> sit amet<br>consectetur adipiscing elit";
+    const QString styledLines = "<b>Lorem</b><br>ipsum<br><i>dolor</i><br>sit<br>amet<br>consectetur<br>adipiscing<br>elit";
+
+    QTest::newRow("plain") << plain << plainLines << "textFormat: Text.PlainText";
+    QTest::newRow("wrapped") << plain << plainLines << "textFormat: Text.PlainText; width: 120; wrapMode: Text.WordWrap";
+    QTest::newRow("centered") << plain << plainLines << "textFormat: Text.PlainText; horizontalAlignment: Text.AlignHCenter";
+    QTest::newRow("line height") << plain << plainLines << "textFormat: Text.PlainText; lineHeight: 1.5";
+    QTest::newRow("styled") << styled << styledLines << "textFormat: Text.StyledText";
+    QTest::newRow("styled wrapped") << styled << styledLines << "textFormat: Text.StyledText; width: 120; wrapMode: Text.WordWrap";
+}
+
+void tst_qquicktext::asynchronousLayout()
+{
+    QFETCH(QString, text);
+    QFETCH(QString, newText);
+    QFETCH(QString, properties);
+
+    const QString componentStr = "import QtQuick 2.3\nText { text: \"%1\"; %2; asynchronous: %3 }";
+
+    QQmlComponent syncComponent(&engine);
+    syncComponent.setData(componentStr.arg(text).arg(properties).arg("false").toLatin1(), QUrl());
+    QScopedPointer<QObject> syncObject(syncComponent.create());
+    QQuickText *syncText = qobject_cast<QQuickText *>(syncObject.data());
+    QVERIFY(syncText);
+
+    QQmlComponent asyncComponent(&engine);
+    asyncComponent.setData(componentStr.arg(text).arg(properties).arg("true").toLatin1(), QUrl());
+    QScopedPointer<QObject> asyncObject(asyncComponent.create());
+    QQuickText *asyncText = qobject_cast<QQuickText *>(asyncObject.data());
+    QVERIFY(asyncText);
+    QVERIFY(asyncText->asynchronous());
+
+    QTRY_COMPARE(asyncText->lineCount(), syncText->lineCount());
+    QTRY_COMPARE(asyncText->contentWidth(), syncText->contentWidth());
+    QCOMPARE(asyncText->contentHeight(), syncText->contentHeight());
+    QCOMPARE(asyncText->implicitWidth(), syncText->implicitWidth());
+    QCOMPARE(asyncText->implicitHeight(), syncText->implicitHeight());
+    QCOMPARE(asyncText->baselineOffset(), syncText->baselineOffset());
+
+    // The previous layout is kept until the new one is ready.
+    QSignalSpy lineCountSpy(asyncText, SIGNAL(lineCountChanged()));
+    const int previousLineCount = asyncText->lineCount();
+    newText.replace("\\n", "\n");
+    asyncText->setText(newText);
+    syncText->setText(newText);
+    QCOMPARE(QQuickTextPrivate::get(asyncText)->lineCount, previousLineCount);
+    QTRY_COMPARE(lineCountSpy.count(), 1);
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->contentHeight(), syncText->contentHeight());
+
+    // Eliding is always laid out synchronously.
+    asyncText->setWidth(30);
+    asyncText->setElideMode(QQuickText::ElideRight);
+    syncText->setWidth(30);
+    syncText->setElideMode(QQuickText::ElideRight);
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->truncated(), syncText->truncated());
+}
+
+void tst_qquicktext::asynchronousLayoutCleared()
+{
+    if (!QFontDatabase::supportsThreadedFontRendering())
+        QSKIP("Text is always laid out synchronously without threaded font rendering");
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.3\nText { asynchronous: true }", QUrl());
+    QScopedPointer<QObject> object(component.create());
+    QQuickText *text = qobject_cast<QQuickText *>(object.data());
+    QVERIFY(text);
+
+    const qreal emptyHeight = text->contentHeight();
+
+    // Clearing the text while a layout of it is pending discards that layout.
+    text->setText(QString(1000, QLatin1Char('x')));
+    text->setText(QString());
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+
+    QCOMPARE(text->contentWidth(), qreal(0));
+    QCOMPARE(text->contentHeight(), emptyHeight);
+    QCOMPARE(text->implicitWidth(), qreal(0));
+    QVERIFY(!QQuickTextPrivate::get(text)->extra->layoutJob);
+    QVERIFY(!QQuickTextPrivate::get(text)->extra->asyncLayout);
+}
+
 QTEST_MAIN(tst_qquicktext)
 
 #include "tst_qquicktext.moc"
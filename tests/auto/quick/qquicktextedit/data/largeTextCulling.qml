@@ -0,0 +1,22 @@
+import QtQuick 2.0
+
+Flickable {
+    width: 200; height: 200
+    clip: true
+    contentWidth: edit.width
+    contentHeight: edit.height
+
+    property alias edit: edit
+
+    TextEdit {
+        id: edit
+        width: 200
+        wrapMode: TextEdit.Wrap
+        Component.onCompleted: {
+            var lines = [];
+            for (var i = 0; i < 2000; ++i)
+                lines.push("Line " + i + " of a document large enough to be culled");
+            text = lines.join("\n");
+        }
+    }
+}
@@ -51,6 +51,7 @@
 #include <QtGui/qguiapplication.h>
 #include <private/qquicktextedit_p.h>
 #include <private/qquicktextedit_p_p.h>
+#include <private/qquickflickable_p.h>
 #include <private/qquicktext_p_p.h>
 #include <QFontMetrics>
 #include <QtQuick/QQuickView>
@@ -206,6 +207,8 @@ private slots:
 
     void emptytags_QTBUG_22058();
 
+    void largeTextCulling();
+
 private:
     void simulateKeys(QWindow *window, const QList<Key> &keys);
     void simulateKeys(QWindow *window, const QKeySequence &sequence);
@@ -5191,6 +5194,37 @@ void tst_qquicktextedit::emptytags_QTBUG_22058()
     QCOMPARE(input->text(), QString("<b>Bold<>"));
 }
 
+void tst_qquicktextedit::largeTextCulling()
+{
+    QQuickView window(testFileUrl("largeTextCulling.qml"));
+    QQuickFlickable *flickable = qobject_cast<QQuickFlickable *>(window.rootObject());
+    QVERIFY(flickable);
+    QQuickTextEdit *edit = qobject_cast<QQuickTextEdit *>(qvariant_cast<QObject *>(flickable->property("edit")));
+    QVERIFY(edit);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickTextEditPrivate *editPrivate = QQuickTextEditPrivate::get(edit);
+    QVERIFY(editPrivate->observesViewport);
+    QTRY_VERIFY(!editPrivate->textNodeMap.isEmpty());
+
+    // Only the nodes near the top of the document have content.
+    QTRY_VERIFY(!editPrivate->textNodeMap.first()->culled());
+    QVERIFY(editPrivate->textNodeMap.last()->culled());
+
+    // Scrolling to the end regenerates the nodes brought into view.
+    flickable->setContentY(flickable->contentHeight() - flickable->height());
+    QTRY_VERIFY(!editPrivate->textNodeMap.last()->culled());
+    QVERIFY(editPrivate->textNodeMap.first()->culled());
+
+    // Small documents are never culled.
+    edit->setText("Hello World");
+    QVERIFY(!editPrivate->observesViewport);
+    QTRY_COMPARE(editPrivate->textNodeMap.count(), 1);
+    QVERIFY(!editPrivate->textNodeMap.first()->culled());
+}
+
 QTEST_MAIN(tst_qquicktextedit)
 
 #include "tst_qquicktextedit.moc"
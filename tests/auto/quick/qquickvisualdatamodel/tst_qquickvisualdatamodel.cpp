@@ -53,6 +53,7 @@
 #include <private/qquicklistview_p.h>
 #include <QtQuick/private/qquicktext_p.h>
 #include <QtQml/private/qqmldelegatemodel_p.h>
+#include <QtQml/private/qqmladaptormodel_p.h>
 #include <private/qqmlvaluetype_p.h>
 #include <private/qqmlchangeset_p.h>
 #include <private/qqmlengine_p.h>
@@ -246,6 +247,41 @@ private:
     Branch trunk;
 };
 
+class MultiDataModel : public SingleRoleModel, public QQmlAdaptorModelMultiDataInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(QQmlAdaptorModelMultiDataInterface)
+public:
+    MultiDataModel(const QStringList &list)
+        : SingleRoleModel(list), dataCalls(0), multiDataCalls(0), multiDataRows(0) {
+        QHash<int, QByteArray> roles;
+        roles.insert(Qt::DisplayRole, "name");
+        roles.insert(Qt::UserRole, "unused");
+        setRoleNames(roles);
+    }
+
+    QVariant data(const QModelIndex &index, int role) const {
+        ++dataCalls;
+        return SingleRoleModel::data(index, role);
+    }
+
+    void multiData(const QModelIndex &parent, int row, int count, const QVector<int> &roles, QVariant *data) const {
+        ++multiDataCalls;
+        multiDataRows += count;
+        foreach (int role, roles)
+            fetchedRoles.insert(role);
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < roles.count(); ++j)
+                *data++ = SingleRoleModel::data(index(row + i, 0, parent), roles.at(j));
+        }
+    }
+
+    mutable int dataCalls;
+    mutable int multiDataCalls;
+    mutable int multiDataRows;
+    mutable QSet<int> fetchedRoles;
+};
+
 class StandardItem : public QObject, public QStandardItem
 {
     Q_OBJECT
@@ -403,6 +439,7 @@ private slots:
     void itemsDestroyed();
     void objectListModel();
     void singleRole();
+    void multiData();
     void modelProperties();
     void packagesDestroyed();
     void qaimRowsMoved();
@@ -765,6 +802,59 @@ void tst_qquickvisualdatamodel::singleRole()
     }
 }
 
+void tst_qquickvisualdatamodel::multiData()
+{
+    QStringList list = QStringList() << "one" << "two" << "three" << "four";
+
+    QQuickView view;
+
+    MultiDataModel model(list);
+
+    QQmlContext *ctxt = view.rootContext();
+    ctxt->setContextProperty("myModel", &model);
+
+    view.setSource(testFileUrl("singlerole1.qml"));
+
+    QQuickListView *listview = qobject_cast<QQuickListView*>(view.rootObject());
+    QVERIFY(listview != 0);
+
+    QQuickItem *contentItem = listview->contentItem();
+    QVERIFY(contentItem != 0);
+
+    for (int i = 0; i < list.count(); ++i) {
+        QQuickText *name = findItem<QQuickText>(contentItem, "name", i);
+        QVERIFY(name);
+        QCOMPARE(name->text(), list.at(i));
+    }
+
+    // Role values are only read through the multi data interface, one row at a time, and
+    // roles the delegate doesn't read are never fetched.
+    QCOMPARE(model.dataCalls, 0);
+    QCOMPARE(model.multiDataCalls, list.count());
+    QCOMPARE(model.fetchedRoles, QSet<int>() << Qt::DisplayRole);
+
+    // Reading the value again uses the fetched row.
+    QQuickText *name = findItem<QQuickText>(contentItem, "name", 1);
+    QVariant text;
+    QVERIFY(QMetaObject::invokeMethod(name, "getText", Q_RETURN_ARG(QVariant, text)));
+    QCOMPARE(text.toString(), QString("two"));
+    QCOMPARE(model.multiDataCalls, list.count());
+
+    // A change refetches the affected rows of all delegates with one call.
+    model.multiDataCalls = 0;
+    model.multiDataRows = 0;
+    model.set(1, "Changed");
+    QCOMPARE(name->text(), QString("Changed"));
+    QCOMPARE(model.multiDataCalls, 1);
+    QCOMPARE(model.multiDataRows, 1);
+    QCOMPARE(model.dataCalls, 0);
+
+    // Changes to roles no delegate has read don't fetch anything.
+    emit model.dataChanged(model.index(0, 0), model.index(3, 0), QVector<int>() << Qt::UserRole);
+    QCOMPARE(model.multiDataCalls, 1);
+    QCOMPARE(model.fetchedRoles, QSet<int>() << Qt::DisplayRole);
+}
+
 void tst_qquickvisualdatamodel::modelProperties()
 {
     {
@@ -53,6 +53,7 @@
 #include <QSignalSpy>
 #include <qpa/qwindowsysteminterface.h>
 #include <private/qquickwindow_p.h>
+#include <private/qsgrenderloop_p.h>
 #include <private/qguiapplication_p.h>
 
 struct TouchEventData {
@@ -300,6 +301,7 @@ private slots:
     void constantUpdates();
     void constantUpdatesOnWindow_data();
     void constantUpdatesOnWindow();
+    void frameTimings();
     void mouseFiltering();
     void headless();
     void noUpdateWhenNothingChanges();
@@ -371,6 +373,29 @@ void tst_qquickwindow::constantUpdates()
     QTRY_VERIFY(spy.count() > 10);
 }
 
+void tst_qquickwindow::frameTimings()
+{
+    QQuickWindow window;
+    window.resize(250, 250);
+    ConstantUpdateItem item(window.contentItem());
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QTRY_VERIFY(item.iterations > 10);
+
+    QSGRenderLoop *loop = QSGRenderLoop::instance();
+    QSGFrameTimings timings = loop->frameTimings(&window);
+    if (!timings.isValid())
+        QSKIP("The render loop does not measure frame timings");
+
+    QVERIFY(timings.polish >= 0);
+    QVERIFY(timings.wait >= 0);
+    QVERIFY(timings.sync >= 0);
+    QVERIFY(timings.render >= 0);
+    QVERIFY(timings.swap >= 0);
+    QTRY_VERIFY(loop->frameTimings(&window).frameInterval > 0);
+}
+
 void tst_qquickwindow::constantUpdatesOnWindow_data()
 {
     QTest::addColumn<bool>("blockedGui");
@@ -0,0 +1,10 @@
+import QtQuick 2.0
+import QtQuick.XmlListModel 2.0
+
+XmlListModel {
+    query: "/data/item"
+    XmlRole { name: "name"; query: "name/string()" }
+    XmlRole { name: "age"; query: "age/number()" }
+    XmlRole { name: "id"; query: "@id/string()" }
+    XmlRole { name: "text"; query: "string()" }
+}
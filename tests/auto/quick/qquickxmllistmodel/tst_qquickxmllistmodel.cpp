@@ -104,6 +104,8 @@ private slots:
     void threading_data();
     void propertyChanges();
     void selectAncestor();
+    void streaming();
+    void streamingRows();
 
     void roleCrash();
 
@@ -979,6 +981,87 @@ void tst_qquickxmllistmodel::selectAncestor()
     QCOMPARE(model->data(index, Qt::UserRole+1).toString(), QLatin1String("cats"));
 }
 
+void tst_qquickxmllistmodel::streaming()
+{
+    // The same queries give the same results when read in a single pass as when evaluated
+    // with XQuery, which is used as soon as namespaces are declared.
+    const QString xml = QLatin1String(
+            "<data>"
+            "<item id=\"1\"><name>Polly</name><age>12</age></item>"
+            "<item><name>Pe<b>n</b>ny</name><age>4.5</age></item>"
+            "<item id=\"\"><age>none</age></item>"
+            "<item id=\"4\"><name></name><age></age></item>"
+            "<other><item><name>Nested</name></item></other>"
+            "</data>");
+
+    QQmlComponent component(&engine, testFileUrl("streaming.qml"));
+    QScopedPointer<QAbstractItemModel> streamed(qobject_cast<QAbstractItemModel *>(component.create()));
+    QVERIFY(streamed);
+    QScopedPointer<QAbstractItemModel> queried(qobject_cast<QAbstractItemModel *>(component.create()));
+    QVERIFY(queried);
+
+    streamed->setProperty("xml", xml);
+    queried->setProperty("namespaceDeclarations", QLatin1String("declare namespace unused = \"http://unused\";"));
+    queried->setProperty("xml", xml);
+
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(streamed->property("status")), QQuickXmlListModel::Ready);
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(queried->property("status")), QQuickXmlListModel::Ready);
+    QCOMPARE(streamed->rowCount(), 4);
+    QCOMPARE(queried->rowCount(), 4);
+
+    for (int row = 0; row < 4; ++row) {
+        for (int role = Qt::UserRole; role < Qt::UserRole + 4; ++role) {
+            const QVariant expected = queried->data(queried->index(row, 0), role);
+            const QVariant actual = streamed->data(streamed->index(row, 0), role);
+            if (expected.type() == QVariant::Double && qIsNaN(expected.toDouble()))
+                QVERIFY(qIsNaN(actual.toDouble()));
+            else
+                QCOMPARE(actual, expected);
+        }
+    }
+
+    // Nothing is returned from a document that isn't well formed.
+    streamed->setProperty("xml", QLatin1String("<data><item><name>Polly</name></item><item>"));
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(streamed->property("status")), QQuickXmlListModel::Ready);
+    QCOMPARE(streamed->rowCount(), 0);
+}
+
+void tst_qquickxmllistmodel::streamingRows()
+{
+    // Large documents are added to the model in several steps while they are read.
+    const int count = 2500;
+    QString xml = QLatin1String("<data>");
+    for (int i = 0; i < count; ++i)
+        xml += QString::fromLatin1("<item id=\"%1\"><name>Item%1</name><age>%1</age></item>").arg(i);
+    xml += QLatin1String("</data>");
+
+    QQmlComponent component(&engine, testFileUrl("streaming.qml"));
+    QScopedPointer<QAbstractItemModel> model(qobject_cast<QAbstractItemModel *>(component.create()));
+    QVERIFY(model);
+
+    QSignalSpy countSpy(model.data(), SIGNAL(countChanged()));
+    QSignalSpy insertSpy(model.data(), SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    model->setProperty("xml", xml);
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(model->property("status")), QQuickXmlListModel::Ready);
+    QCOMPARE(model->rowCount(), count);
+    QVERIFY(countSpy.count() > 1);
+    QVERIFY(insertSpy.count() > 1);
+
+    int inserted = 0;
+    for (int i = 0; i < insertSpy.count(); ++i) {
+        QCOMPARE(insertSpy.at(i).at(1).toInt(), inserted);
+        inserted = insertSpy.at(i).at(2).toInt() + 1;
+    }
+    QCOMPARE(inserted, count);
+
+    const QModelIndex index = model->index(1234, 0);
+    QCOMPARE(model->data(index, Qt::UserRole).toString(), QLatin1String("Item1234"));
+    QCOMPARE(model->data(index, Qt::UserRole + 1).toDouble(), 1234.0);
+    QCOMPARE(model->data(index, Qt::UserRole + 2).toString(), QLatin1String("1234"));
+    QCOMPARE(model->data(index, Qt::UserRole + 3).toString(), QLatin1String("Item12341234"));
+}
+
 void tst_qquickxmllistmodel::roleCrash()
 {
     // don't crash
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtQuick/private/qsgatlastexture_p.h>
+
+class tst_qsgatlastexture : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgatlastexture() : surface(0), context(0) {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void pages();
+
+private:
+    QOffscreenSurface *surface;
+    QOpenGLContext *context;
+};
+
+void tst_qsgatlastexture::initTestCase()
+{
+    // Pages of 512x512 which hold one of the 300x300 images used below
+    qputenv("QSG_ATLAS_WIDTH", "512");
+    qputenv("QSG_ATLAS_HEIGHT", "512");
+    qputenv("QSG_ATLAS_SIZE_LIMIT", "400");
+    qputenv("QSG_ATLAS_PAGE_LIMIT", "3");
+
+    surface = new QOffscreenSurface;
+    surface->create();
+
+    context = new QOpenGLContext;
+    QVERIFY(context->create());
+    QVERIFY(context->makeCurrent(surface));
+}
+
+void tst_qsgatlastexture::cleanupTestCase()
+{
+    if (context)
+        context->doneCurrent();
+    delete context;
+    delete surface;
+}
+
+void tst_qsgatlastexture::pages()
+{
+    QSGAtlasTexture::Manager manager;
+
+    QImage image(300, 300, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+
+    QScopedPointer<QSGTexture> first(manager.create(image));
+    QVERIFY(first);
+    QVERIFY(first->isAtlasTexture());
+    QCOMPARE(manager.pageCount(), 1);
+
+    // Images which don't fit into the existing pages overflow into new ones.
+    QScopedPointer<QSGTexture> second(manager.create(image));
+    QVERIFY(second);
+    QCOMPARE(manager.pageCount(), 2);
+    QVERIFY(second->textureId() != first->textureId());
+
+    QScopedPointer<QSGTexture> third(manager.create(image));
+    QVERIFY(third);
+    QCOMPARE(manager.pageCount(), 3);
+
+    // Past the page limit, images are left for a texture of their own.
+    QVERIFY(!manager.create(image));
+    QCOMPARE(manager.pageCount(), 3);
+
+    // Empty pages are released when the next image is added, except for a spare one
+    // which takes the image.
+    second.reset();
+    third.reset();
+    QCOMPARE(manager.pageCount(), 3);
+    second.reset(manager.create(image));
+    QVERIFY(second);
+    QCOMPARE(manager.pageCount(), 2);
+    QVERIFY(second->textureId() != first->textureId());
+
+    first.reset();
+    second.reset();
+    manager.invalidate();
+    QCOMPARE(manager.pageCount(), 0);
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+}
+
+QTEST_MAIN(tst_qsgatlastexture)
+
+#include "tst_qsgatlastexture.moc"
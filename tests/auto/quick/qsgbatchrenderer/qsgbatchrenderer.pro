@@ -0,0 +1,10 @@
+CONFIG += testcase
+TARGET = tst_qsgbatchrenderer
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qsgbatchrenderer.cpp
+
+CONFIG += parallel_test
+
+QT += core-private gui-private qml quick-private testlib
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,397 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
+#include <QtQuick/qsggeometry.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+
+using namespace QSGBatchRenderer;
+
+class tst_qsgbatchrenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgbatchrenderer() {}
+
+private slots:
+    void overlapIndex_data();
+    void overlapIndex();
+    void alphaBatches_data();
+    void alphaBatches();
+    void occluderGeometry();
+    void occlusionBuffer();
+    void occlusionAfterMove();
+    void shaderEffectIsNoOccluder();
+};
+
+struct TestElement {
+    Rect bounds;
+    int material;
+    int batch;
+};
+
+static Rect randomRect(float extent, float maxSize)
+{
+    Rect r;
+    float x = (qrand() % 10000) / 10000.0f * extent - maxSize;
+    float y = (qrand() % 10000) / 10000.0f * extent - maxSize;
+    float w = (qrand() % 10000) / 10000.0f * maxSize;
+    float h = (qrand() % 10000) / 10000.0f * maxSize;
+    r.set(x, y, x + w, y + h);
+    return r;
+}
+
+/*
+    The batching algorithm of Renderer::prepareAlphaBatches(), with elements reduced to
+    their bounds and a material id which decides compatibility.
+ */
+template <typename OverlapCheck>
+static void assignBatches(QVector<TestElement> *elements, OverlapCheck &overlaps)
+{
+    int batchCount = 0;
+    for (int i = 0; i < elements->size(); ++i) {
+        TestElement &ei = (*elements)[i];
+        if (ei.batch >= 0)
+            continue;
+        ei.batch = batchCount++;
+        overlaps.clear();
+        for (int j = i + 1; j < elements->size(); ++j) {
+            TestElement &ej = (*elements)[j];
+            if (ej.batch >= 0)
+                continue;
+            if (ej.material == ei.material) {
+                if (!overlaps.intersects(ej.bounds))
+                    ej.batch = ei.batch;
+                else
+                    break;
+            } else {
+                overlaps.add(ej.bounds);
+            }
+        }
+    }
+}
+
+// The overlap check as it was done before OverlapIndex: the union of all bounds,
+// followed by a linear search.
+class LinearOverlaps
+{
+public:
+    void clear() {
+        rects.clear();
+        bounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    }
+    void add(const Rect &r) {
+        rects.append(r);
+        bounds |= r;
+    }
+    bool intersects(const Rect &r) const {
+        if (!bounds.intersects(r))
+            return false;
+        for (int i = 0; i < rects.size(); ++i) {
+            if (rects.at(i).intersects(r))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    QVector<Rect> rects;
+    Rect bounds;
+};
+
+void tst_qsgbatchrenderer::overlapIndex_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<float>("maxSize");
+
+    QTest::newRow("linear") << int(OverlapIndex::LinearLimit) << 100.0f;
+    QTest::newRow("small rects") << 1000 << 20.0f;
+    QTest::newRow("large rects") << 1000 << 800.0f;
+}
+
+void tst_qsgbatchrenderer::overlapIndex()
+{
+    QFETCH(int, count);
+    QFETCH(float, maxSize);
+
+    qsrand(count);
+
+    OverlapIndex index;
+    LinearOverlaps reference;
+    index.clear();
+    reference.clear();
+
+    for (int i = 0; i < count; ++i) {
+        Rect r = randomRect(1000, maxSize);
+        index.add(r);
+        reference.add(r);
+
+        // Queries partly outside of the area the grid was built for
+        for (int q = 0; q < 10; ++q) {
+            Rect query = randomRect(1400, maxSize);
+            QCOMPARE(index.intersects(query), reference.intersects(query));
+        }
+    }
+
+    // Degenerate sets, where the grid collapses to a single row or column
+    index.clear();
+    reference.clear();
+    for (int i = 0; i < 100; ++i) {
+        Rect r;
+        r.set(10, i * 10, 10, i * 10 + 15);
+        index.add(r);
+        reference.add(r);
+        Rect query;
+        query.set(5, i * 5, 15, i * 5 + 2);
+        QCOMPARE(index.intersects(query), reference.intersects(query));
+    }
+}
+
+void tst_qsgbatchrenderer::alphaBatches_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("materials");
+    QTest::addColumn<float>("maxSize");
+
+    QTest::newRow("one material") << 500 << 1 << 100.0f;
+    QTest::newRow("two materials, small") << 2000 << 2 << 20.0f;
+    QTest::newRow("two materials, large") << 2000 << 2 << 400.0f;
+    QTest::newRow("many materials") << 2000 << 10 << 50.0f;
+}
+
+void tst_qsgbatchrenderer::alphaBatches()
+{
+    QFETCH(int, count);
+    QFETCH(int, materials);
+    QFETCH(float, maxSize);
+
+    qsrand(count * materials);
+
+    QVector<TestElement> elements;
+    for (int i = 0; i < count; ++i) {
+        TestElement e = { randomRect(1000, maxSize), qrand() % materials, -1 };
+        elements.append(e);
+    }
+    QVector<TestElement> expected = elements;
+
+    LinearOverlaps reference;
+    assignBatches(&expected, reference);
+    OverlapIndex index;
+    assignBatches(&elements, index);
+
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(elements.at(i).batch, expected.at(i).batch);
+}
+
+void tst_qsgbatchrenderer::occluderGeometry()
+{
+    // Rectangles and images
+    QSGGeometry rect(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4);
+    QSGGeometry::updateTexturedRectGeometry(&rect, QRectF(10, 20, 100, 50), QRectF(0, 0, 1, 1));
+    QVERIFY(OcclusionBuffer::fillsBounds(&rect));
+
+    // A strip of horizontal rungs, as used for gradients, through indices
+    QSGGeometry ladder(QSGGeometry::defaultAttributes_Point2D(), 6, 6);
+    QSGGeometry::Point2D *v = ladder.vertexDataAsPoint2D();
+    quint16 *indices = ladder.indexDataAsUShort();
+    for (int i = 0; i < 3; ++i) {
+        // Vertices are stored in reverse order
+        v[5 - i * 2].set(100, i * 10);
+        v[4 - i * 2].set(0, i * 10);
+        indices[i * 2] = 5 - i * 2;
+        indices[i * 2 + 1] = 4 - i * 2;
+    }
+    QVERIFY(OcclusionBuffer::fillsBounds(&ladder));
+
+    // A rung which does not span the full width leaves a gap
+    v[indices[2]].set(50, 10);
+    QVERIFY(!OcclusionBuffer::fillsBounds(&ladder));
+
+    // Corners in the wrong order leave half of the rect uncovered
+    QSGGeometry crossed(QSGGeometry::defaultAttributes_Point2D(), 4);
+    v = crossed.vertexDataAsPoint2D();
+    v[0].set(0, 0);
+    v[1].set(10, 10);
+    v[2].set(10, 0);
+    v[3].set(0, 10);
+    QVERIFY(!OcclusionBuffer::fillsBounds(&crossed));
+
+    // Other drawing modes
+    rect.setDrawingMode(GL_TRIANGLES);
+    QVERIFY(!OcclusionBuffer::fillsBounds(&rect));
+}
+
+void tst_qsgbatchrenderer::occlusionBuffer()
+{
+    const Node *root = reinterpret_cast<const Node *>(quintptr(0x10));
+    const Node *otherRoot = reinterpret_cast<const Node *>(quintptr(0x20));
+    const QSGClipNode *clip = reinterpret_cast<const QSGClipNode *>(quintptr(0x30));
+
+    OcclusionBuffer buffer;
+    Rect occluder;
+    occluder.set(0, 0, 100, 100);
+    buffer.add(occluder, root, 0);
+
+    Rect inside;
+    inside.set(10, 10, 100, 50);
+    Rect overlapping;
+    overlapping.set(50, 50, 150, 80);
+    QVERIFY(buffer.isOccluded(inside, root, 0));
+    QVERIFY(!buffer.isOccluded(overlapping, root, 0));
+    QVERIFY(!buffer.isOccluded(inside, otherRoot, 0));
+    QVERIFY(!buffer.isOccluded(inside, root, clip));
+
+    // Once full, only occluders larger than the smallest one are kept
+    for (int i = 1; i < OcclusionBuffer::MaxOccluders; ++i) {
+        Rect r;
+        r.set(1000 + i * 10, 0, 1000 + i * 10 + 5, 5);
+        buffer.add(r, root, 0);
+    }
+    QCOMPARE(buffer.count(), int(OcclusionBuffer::MaxOccluders));
+
+    Rect large;
+    large.set(200, 0, 400, 200);
+    buffer.add(large, root, 0);
+    QCOMPARE(buffer.count(), int(OcclusionBuffer::MaxOccluders));
+    QVERIFY(buffer.isOccluded(inside, root, 0));
+    Rect behindLarge;
+    behindLarge.set(250, 50, 300, 100);
+    QVERIFY(buffer.isOccluded(behindLarge, root, 0));
+
+    buffer.clear();
+    QVERIFY(!buffer.isOccluded(inside, root, 0));
+}
+
+void tst_qsgbatchrenderer::occlusionAfterMove()
+{
+    // The renderer reads the variable when it is created for the window
+    qputenv("QSG_RENDERER_OCCLUSION_CULLING", "1");
+
+    QQuickWindow window;
+    window.resize(200, 100);
+    window.setColor(Qt::white);
+
+    // An opaque rectangle in front of a smaller one
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Item {\n"
+                      "    Rectangle { width: 50; height: 50; color: \"red\" }\n"
+                      "    Rectangle {\n"
+                      "        objectName: \"occluder\"\n"
+                      "        width: 100; height: 100\n"
+                      "        color: \"blue\"\n"
+                      "    }\n"
+                      "}\n", QUrl());
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(root);
+    QQuickItem *occluder = root->findChild<QQuickItem *>("occluder");
+    QVERIFY(occluder);
+    root->setParentItem(window.contentItem());
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QImage image = window.grabWindow();
+    QCOMPARE(image.pixel(25, 25), qRgb(0, 0, 255));
+    QCOMPARE(image.pixel(150, 25), qRgb(255, 255, 255));
+
+    // Moving the occluder away shows the rectangle behind it again
+    occluder->setX(100);
+    image = window.grabWindow();
+    QCOMPARE(image.pixel(25, 25), qRgb(255, 0, 0));
+    QCOMPARE(image.pixel(150, 25), qRgb(0, 0, 255));
+
+    // ... and moving it back hides it
+    occluder->setX(0);
+    image = window.grabWindow();
+    QCOMPARE(image.pixel(25, 25), qRgb(0, 0, 255));
+    QCOMPARE(image.pixel(150, 25), qRgb(255, 255, 255));
+
+    qunsetenv("QSG_RENDERER_OCCLUSION_CULLING");
+}
+
+void tst_qsgbatchrenderer::shaderEffectIsNoOccluder()
+{
+    qputenv("QSG_RENDERER_OCCLUSION_CULLING", "1");
+
+    QQuickWindow window;
+    window.resize(200, 100);
+    window.setColor(Qt::white);
+
+    // The opaque shader effect covers the rectangle with its geometry, but its vertex
+    // shader moves it to the right, so the rectangle must still be drawn.
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Item {\n"
+                      "    Rectangle { width: 50; height: 50; color: \"red\" }\n"
+                      "    ShaderEffect {\n"
+                      "        width: 100; height: 100\n"
+                      "        blending: false\n"
+                      "        vertexShader: \"uniform highp mat4 qt_Matrix; attribute highp vec4 qt_Vertex;\"\n"
+                      "                    + \"void main() { gl_Position = qt_Matrix * (qt_Vertex + vec4(100.0, 0.0, 0.0, 0.0)); }\"\n"
+                      "        fragmentShader: \"uniform lowp float qt_Opacity;\"\n"
+                      "                      + \"void main() { gl_FragColor = vec4(0.0, 0.0, 1.0, 1.0) * qt_Opacity; }\"\n"
+                      "    }\n"
+                      "}\n", QUrl());
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(root);
+    root->setParentItem(window.contentItem());
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QImage image = window.grabWindow();
+    QCOMPARE(image.pixel(25, 25), qRgb(255, 0, 0));
+    QCOMPARE(image.pixel(150, 25), qRgb(0, 0, 255));
+
+    qunsetenv("QSG_RENDERER_OCCLUSION_CULLING");
+}
+
+QTEST_MAIN(tst_qsgbatchrenderer)
+
+#include "tst_qsgbatchrenderer.moc"
@@ -0,0 +1,10 @@
+CONFIG += testcase
+TARGET = tst_qsgdistancefieldglyphcache
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qsgdistancefieldglyphcache.cpp
+
+CONFIG += parallel_test
+
+QT += core-private gui-private quick-private testlib
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
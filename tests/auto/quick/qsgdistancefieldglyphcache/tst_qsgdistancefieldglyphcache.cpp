@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtCore/QDataStream>
+#include <QtQuick/private/qsgdefaultdistancefieldglyphcache_p.h>
+
+typedef QSGDistanceFieldDiskCache::Record Record;
+
+class tst_qsgdistancefieldglyphcache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void truncated();
+    void corrupted();
+    void wrongHeader();
+};
+
+static Record record(glyph_t glyph, int width)
+{
+    Record r;
+    r.glyph = glyph;
+    r.boundingRect = QRectF(1, 2, width - 8, 24);
+    r.field = QDistanceField(width, 32);
+    for (int y = 0; y < r.field.height(); ++y) {
+        uchar *line = r.field.scanLine(y);
+        for (int x = 0; x < r.field.width(); ++x)
+            line[x] = uchar(glyph + x * y);
+    }
+    return r;
+}
+
+// A cache file holding a record for glyphs 1, 2 and 3, and the offset at which each record ends
+static QByteArray cacheFile(QList<int> *ends)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    QSGDistanceFieldDiskCache::writeHeader(out);
+    for (int i = 1; i <= 3; ++i) {
+        QSGDistanceFieldDiskCache::writeRecord(out, record(i, 10 + i));
+        ends->append(data.size());
+    }
+    return data;
+}
+
+// Returns the glyphs of the records read from the start of data
+static QList<glyph_t> readGlyphs(const QByteArray &data)
+{
+    QList<glyph_t> glyphs;
+    QDataStream in(data);
+    if (!QSGDistanceFieldDiskCache::readHeader(in))
+        return glyphs;
+    Record r;
+    while (!in.atEnd() && QSGDistanceFieldDiskCache::readRecord(in, &r))
+        glyphs.append(r.glyph);
+    return glyphs;
+}
+
+void tst_qsgdistancefieldglyphcache::roundTrip()
+{
+    QList<int> ends;
+    QByteArray data = cacheFile(&ends);
+
+    QDataStream in(data);
+    QVERIFY(QSGDistanceFieldDiskCache::readHeader(in));
+    for (int i = 1; i <= 3; ++i) {
+        Record expected = record(i, 10 + i);
+        Record r;
+        QVERIFY(QSGDistanceFieldDiskCache::readRecord(in, &r));
+        QCOMPARE(r.glyph, expected.glyph);
+        QCOMPARE(r.boundingRect, expected.boundingRect);
+        QCOMPARE(r.field.width(), expected.field.width());
+        QCOMPARE(r.field.height(), expected.field.height());
+        QCOMPARE(QByteArray(reinterpret_cast<const char *>(r.field.constBits()), r.field.width() * r.field.height()),
+                 QByteArray(reinterpret_cast<const char *>(expected.field.constBits()), expected.field.width() * expected.field.height()));
+    }
+    QVERIFY(in.atEnd());
+}
+
+void tst_qsgdistancefieldglyphcache::truncated()
+{
+    QList<int> ends;
+    QByteArray data = cacheFile(&ends);
+
+    // Reading stops at the record which was cut short
+    QCOMPARE(readGlyphs(data.left(ends.at(2) - 1)), QList<glyph_t>() << 1 << 2);
+    QCOMPARE(readGlyphs(data.left(ends.at(1) + 3)), QList<glyph_t>() << 1 << 2);
+    QCOMPARE(readGlyphs(data.left(ends.at(0) + 1)), QList<glyph_t>() << 1);
+    QCOMPARE(readGlyphs(data.left(4)), QList<glyph_t>());
+}
+
+void tst_qsgdistancefieldglyphcache::corrupted()
+{
+    QList<int> ends;
+    QByteArray data = cacheFile(&ends);
+
+    // A changed byte in the field of the second record, or in its checksum,
+    // stops reading before that record
+    QByteArray field = data;
+    field[ends.at(1) - 10] = field.at(ends.at(1) - 10) ^ 0x40;
+    QCOMPARE(readGlyphs(field), QList<glyph_t>() << 1);
+
+    QByteArray checksum = data;
+    checksum[ends.at(1) - 1] = checksum.at(ends.at(1) - 1) ^ 0x01;
+    QCOMPARE(readGlyphs(checksum), QList<glyph_t>() << 1);
+
+    // So does a length which runs past the end of the file
+    QByteArray length = data;
+    length[ends.at(0)] = 0x7f;
+    QCOMPARE(readGlyphs(length), QList<glyph_t>() << 1);
+}
+
+void tst_qsgdistancefieldglyphcache::wrongHeader()
+{
+    QList<int> ends;
+    QByteArray data = cacheFile(&ends);
+
+    QByteArray magic = data;
+    magic[0] = magic.at(0) ^ 0x01;
+    QCOMPARE(readGlyphs(magic), QList<glyph_t>());
+
+    // Files of another version are not read
+    QByteArray version = data;
+    version[7] = version.at(7) + 1;
+    QCOMPARE(readGlyphs(version), QList<glyph_t>());
+}
+
+QTEST_MAIN(tst_qsgdistancefieldglyphcache)
+
+#include "tst_qsgdistancefieldglyphcache.moc"
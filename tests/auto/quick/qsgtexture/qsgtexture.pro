@@ -0,0 +1,10 @@
+CONFIG += testcase
+TARGET = tst_qsgtexture
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qsgtexture.cpp
+
+CONFIG += parallel_test
+
+QT += core-private gui-private qml quick-private testlib
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/qquickimageprovider.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qsgmaterial.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+
+class ColorImageProvider : public QQuickImageProvider
+{
+public:
+    ColorImageProvider() : QQuickImageProvider(QQuickImageProvider::Image) {}
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &)
+    {
+        QImage image(600, 600, QImage::Format_RGB32);
+        image.fill(QColor(id));
+        if (size)
+            *size = image.size();
+        return image;
+    }
+};
+
+class tst_qsgtexture : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgtexture() {}
+
+public slots:
+    void afterRendering();
+
+private slots:
+    void initTestCase();
+    void uploadBudget();
+
+private:
+    QList<QQuickItem *> images;
+    QAtomicInt pendingUploads;
+    QAtomicInt maxPendingUploads;
+    QAtomicInt blendedImages;
+};
+
+void tst_qsgtexture::initTestCase()
+{
+    // Only the first upload of each frame is made, the others wait for the next frames
+    qputenv("QSG_TEXTURE_UPLOAD_BUDGET", "1");
+    // Images put into the atlas are uploaded with it, outside of the budget
+    qputenv("QSG_ATLAS_SIZE_LIMIT", "0");
+}
+
+// Called on the render thread
+void tst_qsgtexture::afterRendering()
+{
+    QSGRenderContext *rc = QSGRenderContext::from(QOpenGLContext::currentContext());
+    pendingUploads.store(rc->pendingTextureUploads());
+    if (rc->pendingTextureUploads() > maxPendingUploads.load())
+        maxPendingUploads.store(rc->pendingTextureUploads());
+
+    int blended = 0;
+    foreach (QQuickItem *image, images) {
+        QSGGeometryNode *node = static_cast<QSGGeometryNode *>(QQuickItemPrivate::get(image)->paintNode);
+        if (node && node->opaqueMaterial()->flags() & QSGMaterial::Blending)
+            ++blended;
+    }
+    blendedImages.store(blended);
+}
+
+void tst_qsgtexture::uploadBudget()
+{
+    QQuickWindow window;
+    window.resize(210, 70);
+    window.setColor(Qt::white);
+
+    QQmlEngine engine;
+    engine.addImageProvider(QLatin1String("color"), new ColorImageProvider);
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Row {\n"
+                      "    x: 5; y: 5; spacing: 10\n"
+                      "    Image { width: 60; height: 60; source: \"image://color/red\" }\n"
+                      "    Image { width: 60; height: 60; source: \"image://color/lime\" }\n"
+                      "    Image { width: 60; height: 60; source: \"image://color/blue\" }\n"
+                      "}\n", QUrl());
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(root);
+    images = root->childItems();
+    QCOMPARE(images.count(), 3);
+    root->setParentItem(window.contentItem());
+
+    connect(&window, SIGNAL(afterRendering()), this, SLOT(afterRendering()), Qt::DirectConnection);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // One image is uploaded in the first frame, the other two are postponed
+    QTRY_COMPARE(maxPendingUploads.load(), 2);
+
+    // They are uploaded in the following frames, after which the opaque
+    // images are no longer blended
+    QTRY_COMPARE(pendingUploads.load(), 0);
+    QTRY_COMPARE(blendedImages.load(), 0);
+
+    QImage content = window.grabWindow();
+    QCOMPARE(content.pixel(35, 35), qRgb(255, 0, 0));
+    QCOMPARE(content.pixel(105, 35), qRgb(0, 255, 0));
+    QCOMPARE(content.pixel(175, 35), qRgb(0, 0, 255));
+
+    disconnect(&window, SIGNAL(afterRendering()), this, SLOT(afterRendering()));
+    images.clear();
+}
+
+QTEST_MAIN(tst_qsgtexture)
+
+#include "tst_qsgtexture.moc"
@@ -20,6 +20,10 @@ PRIVATETESTS += \
     qquickfontloader \
     qquickimageprovider \
     qquickpath \
+    qsgatlastexture \
+    qsgdistancefieldglyphcache \
+    qsgbatchrenderer \
+    qsgtexture \
     qquicksmoothedanimation \
     qquickspringanimation \
     qquickanimationcontroller \
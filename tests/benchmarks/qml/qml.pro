@@ -12,7 +12,11 @@ SUBDIRS += \
            script \
            qmltime \
            js \
-           qquickwindow
+           qqmllistcompositor \
+           qqmllistmodel \
+           qquickwindow \
+           qsgbatchrenderer \
+           qv4serialize
 
 qtHaveModule(opengl): SUBDIRS += painting
 
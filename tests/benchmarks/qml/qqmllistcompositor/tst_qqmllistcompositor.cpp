@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtQml/private/qqmllistcompositor_p.h>
+
+typedef QQmlListCompositor C;
+
+static const C::Group Visible = C::Group(2);
+static const C::Group Selection = C::Group(3);
+static const int VisibleFlag = 0x04;
+static const int SelectionFlag = 0x08;
+
+// Measures index lookups in a compositor with a million items where group membership alternates
+// from item to item, so that every item is in a range of its own.
+class tst_qqmllistcompositor : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qqmllistcompositor() {}
+
+private slots:
+    void initTestCase();
+
+    void find_data();
+    void find();
+    void findAdjacent_data();
+    void findAdjacent();
+    void findAfterChange();
+
+private:
+    QVector<int> randomIndexes(int count) const;
+
+    C m_compositor;
+    int m_list;
+};
+
+static const int itemCount = 1000000;
+static const int lookupCount = 4096;
+
+void tst_qqmllistcompositor::initTestCase()
+{
+    m_compositor.setGroupCount(4);
+    m_compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+
+    for (int i = 0; i < itemCount; ++i) {
+        int flags = C::DefaultFlag;
+        if (i % 2 == 0)
+            flags |= VisibleFlag;
+        if (i % 3 == 0)
+            flags |= SelectionFlag;
+        m_compositor.append(&m_list, i, 1, flags);
+    }
+}
+
+QVector<int> tst_qqmllistcompositor::randomIndexes(int count) const
+{
+    qsrand(1);
+    QVector<int> indexes;
+    indexes.reserve(lookupCount);
+    for (int i = 0; i < lookupCount; ++i)
+        indexes.append(((qrand() << 15) ^ qrand()) % count);
+    return indexes;
+}
+
+void tst_qqmllistcompositor::find_data()
+{
+    QTest::addColumn<int>("group");
+
+    QTest::newRow("default") << int(C::Default);
+    QTest::newRow("visible") << int(Visible);
+    QTest::newRow("selection") << int(Selection);
+}
+
+void tst_qqmllistcompositor::find()
+{
+    QFETCH(int, group);
+
+    const QVector<int> indexes = randomIndexes(m_compositor.count(C::Group(group)));
+
+    QBENCHMARK {
+        foreach (int index, indexes)
+            m_compositor.find(C::Group(group), index);
+    }
+}
+
+void tst_qqmllistcompositor::findAdjacent_data()
+{
+    find_data();
+}
+
+void tst_qqmllistcompositor::findAdjacent()
+{
+    QFETCH(int, group);
+
+    const int start = m_compositor.count(C::Group(group)) / 2;
+
+    QBENCHMARK {
+        for (int i = 0; i < lookupCount; ++i)
+            m_compositor.find(C::Group(group), start + i);
+    }
+}
+
+void tst_qqmllistcompositor::findAfterChange()
+{
+    // Every change discards the index, a few lookups between changes shouldn't rebuild it.
+    const QVector<int> indexes = randomIndexes(itemCount);
+
+    QBENCHMARK {
+        for (int i = 0; i < lookupCount; i += 4) {
+            const int index = 3 * (indexes.at(i) / 6) + 1;
+            m_compositor.setFlags(C::Default, index, 1, SelectionFlag);
+            m_compositor.clearFlags(C::Default, index, 1, SelectionFlag);
+            for (int j = 1; j < 4; ++j)
+                m_compositor.find(C::Default, indexes.at(i + j));
+        }
+    }
+}
+
+QTEST_MAIN(tst_qqmllistcompositor)
+
+#include "tst_qqmllistcompositor.moc"
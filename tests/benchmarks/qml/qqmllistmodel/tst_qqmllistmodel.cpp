@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQml/private/qqmllistmodel_p.h>
+
+// Compares filling and updating a ListModel one item at a time from script with doing the same
+// through the methods taking arrays of items.
+class tst_qqmllistmodel : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qqmllistmodel() {}
+
+private slots:
+    void run_data();
+    void run();
+};
+
+static const char qmlSource[] =
+        "import QtQml 2.0\n"
+        "import QtQml.Models 2.1\n"
+        "QtObject {\n"
+        "    property ListModel model: ListModel {}\n"
+        "    property var items\n"
+        "    function build(count) {\n"
+        "        var list = []\n"
+        "        for (var i = 0; i < count; ++i)\n"
+        "            list.push({ name: 'item', cost: i, flag: i % 2 == 0 })\n"
+        "        items = list\n"
+        "    }\n"
+        "    function appendEach() { for (var i = 0; i < items.length; ++i) model.append(items[i]) }\n"
+        "    function appendArray() { model.append(items) }\n"
+        "    function insertEach() { for (var i = 0; i < items.length; ++i) model.insert(i, items[i]) }\n"
+        "    function insertArray() { model.insert(0, items) }\n"
+        "    function prepareSet() { model.append(items); for (var i = 0; i < items.length; ++i) items[i].cost = -i }\n"
+        "    function setPropertyEach() { for (var i = 0; i < items.length; ++i) model.setProperty(i, 'cost', items[i].cost) }\n"
+        "    function setRowsArray() { model.setRows(0, items, ['cost']) }\n"
+        "}\n";
+
+void tst_qqmllistmodel::run_data()
+{
+    QTest::addColumn<QByteArray>("prepare");
+    QTest::addColumn<QByteArray>("function");
+    QTest::addColumn<int>("count");
+
+    static const int counts[] = { 1000, 100000 };
+    for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        const int count = counts[i];
+        QTest::newRow(qPrintable(QString("append per item, %1").arg(count))) << QByteArray() << QByteArray("appendEach") << count;
+        QTest::newRow(qPrintable(QString("append array, %1").arg(count))) << QByteArray() << QByteArray("appendArray") << count;
+        QTest::newRow(qPrintable(QString("insert per item, %1").arg(count))) << QByteArray() << QByteArray("insertEach") << count;
+        QTest::newRow(qPrintable(QString("insert array, %1").arg(count))) << QByteArray() << QByteArray("insertArray") << count;
+        QTest::newRow(qPrintable(QString("setProperty per item, %1").arg(count))) << QByteArray("prepareSet") << QByteArray("setPropertyEach") << count;
+        QTest::newRow(qPrintable(QString("setRows, %1").arg(count))) << QByteArray("prepareSet") << QByteArray("setRowsArray") << count;
+    }
+}
+
+void tst_qqmllistmodel::run()
+{
+    QFETCH(QByteArray, prepare);
+    QFETCH(QByteArray, function);
+    QFETCH(int, count);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(qmlSource, QUrl());
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object.data(), qPrintable(component.errorString()));
+
+    QQmlListModel *model = qobject_cast<QQmlListModel *>(object->property("model").value<QObject *>());
+    QVERIFY(model);
+
+    QVERIFY(QMetaObject::invokeMethod(object.data(), "build", Q_ARG(QVariant, count)));
+    if (!prepare.isEmpty())
+        QVERIFY(QMetaObject::invokeMethod(object.data(), prepare.constData()));
+
+    // Each variant changes the model once, so measure a single run.
+    QBENCHMARK_ONCE {
+        QMetaObject::invokeMethod(object.data(), function.constData());
+    }
+
+    QCOMPARE(model->count(), count);
+}
+
+QTEST_MAIN(tst_qqmllistmodel)
+
+#include "tst_qqmllistmodel.moc"
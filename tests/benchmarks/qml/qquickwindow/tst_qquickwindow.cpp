@@ -54,6 +54,8 @@ public:
 
 private slots:
     void tst_updateCursor();
+    void mapToScene_data();
+    void mapToScene();
     void cleanupTestCase();
 private:
     QQuickWindow* window;
@@ -86,6 +88,40 @@ void tst_qquickwindow::tst_updateCursor()
     }
 }
 
+void tst_qquickwindow::mapToScene_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<bool>("moveRoot");
+
+    QTest::newRow("depth 10") << 10 << false;
+    QTest::newRow("depth 100") << 100 << false;
+    QTest::newRow("depth 100, moving root") << 100 << true;
+}
+
+void tst_qquickwindow::mapToScene()
+{
+    QFETCH(int, depth);
+    QFETCH(bool, moveRoot);
+
+    QQuickItem root(window->contentItem());
+    QQuickItem *leaf = &root;
+    for (int i = 0; i < depth; ++i) {
+        QQuickItem *child = new QQuickItem(leaf);
+        child->setPosition(QPointF(1, 1));
+        if (i % 10 == 0)
+            child->setRotation(1);
+        leaf = child;
+    }
+
+    qreal x = 0;
+    QBENCHMARK {
+        if (moveRoot)
+            root.setX(++x);
+        for (int i = 0; i < 100; ++i)
+            leaf->mapToScene(QPointF(i, i));
+    }
+}
+
 QTEST_MAIN(tst_qquickwindow);
 
 #include "tst_qquickwindow.moc"
@@ -0,0 +1,10 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qsgbatchrenderer
+QT += gui quick-private testlib
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_qsgbatchrenderer.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
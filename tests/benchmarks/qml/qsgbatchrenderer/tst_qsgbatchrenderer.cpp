@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtGui/QMatrix4x4>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
+
+using namespace QSGBatchRenderer;
+
+// Measures the vertex kernels used by the batch renderer when it uploads merged
+// batches. These run on the CPU, so no OpenGL context is needed.
+class tst_qsgbatchrenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qsgbatchrenderer() {}
+
+private slots:
+    void translateVertices_data();
+    void translateVertices();
+    void transformVertices_data();
+    void transformVertices();
+    void fillZOrder();
+
+private:
+    static QVector<char> createVertices(int count, int stride);
+};
+
+// Vertex count of 50000 merged rectangles, four vertices each
+static const int vertexCount = 200000;
+
+QVector<char> tst_qsgbatchrenderer::createVertices(int count, int stride)
+{
+    QVector<char> vertices(count * stride);
+    for (int i = 0; i < count; ++i) {
+        Pt *p = (Pt *) (vertices.data() + i * stride);
+        p->set(i % 1000, i / 1000);
+    }
+    return vertices;
+}
+
+void tst_qsgbatchrenderer::translateVertices_data()
+{
+    QTest::addColumn<int>("stride");
+
+    QTest::newRow("ColoredPoint2D") << 12;
+    QTest::newRow("TexturedPoint2D") << 16;
+}
+
+void tst_qsgbatchrenderer::translateVertices()
+{
+    QFETCH(int, stride);
+
+    QVector<char> vertices = createVertices(vertexCount, stride);
+    QVector<char> expected = vertices;
+    for (int i = 0; i < vertexCount; ++i) {
+        Pt *p = (Pt *) (expected.data() + i * stride);
+        p->x += 10.5f;
+        p->y += 20.25f;
+    }
+    QSGBatchRenderer::translateVertices(vertices.data(), vertexCount, stride, 10.5f, 20.25f);
+    QVERIFY(vertices == expected);
+
+    QBENCHMARK {
+        QSGBatchRenderer::translateVertices(vertices.data(), vertexCount, stride, 1.0f, -1.0f);
+    }
+}
+
+void tst_qsgbatchrenderer::transformVertices_data()
+{
+    translateVertices_data();
+}
+
+void tst_qsgbatchrenderer::transformVertices()
+{
+    QFETCH(int, stride);
+
+    QMatrix4x4 matrix;
+    matrix.translate(10, 20);
+    matrix.rotate(30, 0, 0, 1);
+    matrix.scale(1.5);
+
+    QVector<char> vertices = createVertices(vertexCount, stride);
+    QVector<char> expected = vertices;
+    for (int i = 0; i < vertexCount; ++i)
+        ((Pt *) (expected.data() + i * stride))->map(matrix);
+    QSGBatchRenderer::transformVertices(vertices.data(), vertexCount, stride, matrix);
+    QVERIFY(vertices == expected);
+
+    // Keep the values bounded while iterating.
+    QMatrix4x4 identity;
+    identity.scale(1.0f, 1.0f);
+    QBENCHMARK {
+        QSGBatchRenderer::transformVertices(vertices.data(), vertexCount, stride, identity);
+    }
+}
+
+void tst_qsgbatchrenderer::fillZOrder()
+{
+    QVector<float> zData(vertexCount + 3);
+    QSGBatchRenderer::fillZOrder(zData.data(), vertexCount + 3, 0.5f);
+    QCOMPARE(zData.count(0.5f), vertexCount + 3);
+
+    QBENCHMARK {
+        QSGBatchRenderer::fillZOrder(zData.data(), vertexCount, 0.25f);
+    }
+}
+
+QTEST_MAIN(tst_qsgbatchrenderer)
+
+#include "tst_qsgbatchrenderer.moc"
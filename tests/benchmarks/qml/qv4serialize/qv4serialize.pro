@@ -0,0 +1,10 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_qv4serialize
+QT += qml-private testlib
+macx:CONFIG -= app_bundle
+CONFIG += release
+
+SOURCES += tst_qv4serialize.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
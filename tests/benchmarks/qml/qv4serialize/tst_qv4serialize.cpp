@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+
+#include <qtest.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/private/qqmlengine_p.h>
+#include <QtQml/private/qv8engine_p.h>
+#include <QtQml/private/qv4script_p.h>
+#include <QtQml/private/qv4serialize_p.h>
+
+// Measures the cost of passing typical WorkerScript messages between threads.
+class tst_qv4serialize : public QObject
+{
+    Q_OBJECT
+public:
+    tst_qv4serialize() {}
+
+private slots:
+    void serialize_data();
+    void serialize();
+    void deserialize_data() { serialize_data(); }
+    void deserialize();
+};
+
+void tst_qv4serialize::serialize_data()
+{
+    QTest::addColumn<QString>("source");
+
+    QTest::newRow("numbers, 100000")
+            << "(function() { var a = []; for (var i = 0; i < 100000; ++i) a.push(i * 0.5); return a })()";
+    QTest::newRow("integers, 100000")
+            << "(function() { var a = []; for (var i = 0; i < 100000; ++i) a.push(i); return a })()";
+    QTest::newRow("objects, 10000")
+            << "(function() { var a = []; for (var i = 0; i < 10000; ++i) a.push({ name: 'item', cost: i, flag: i % 2 == 0 }); return a })()";
+    QTest::newRow("strings, 10000")
+            << "(function() { var a = []; for (var i = 0; i < 10000; ++i) a.push('string ' + (i % 100)); return a })()";
+    QTest::newRow("nested, 1000")
+            << "(function() { var a = []; for (var i = 0; i < 1000; ++i) a.push({ id: i, points: [i, i + 1, i + 2, i + 3], tags: ['a', 'b'] }); return a })()";
+}
+
+void tst_qv4serialize::serialize()
+{
+    QFETCH(QString, source);
+
+    QQmlEngine engine;
+    QV8Engine *v8 = QQmlEnginePrivate::getV8Engine(&engine);
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(v8);
+    QV4::Scope scope(v4);
+    QV4::ScopedValue value(scope, QV4::Script(v4->rootContext, source).run());
+    QVERIFY(!scope.hasException());
+
+    QByteArray data;
+    QBENCHMARK {
+        data = QV4::Serialize::serialize(value, v8);
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+void tst_qv4serialize::deserialize()
+{
+    QFETCH(QString, source);
+
+    QQmlEngine engine;
+    QV8Engine *v8 = QQmlEnginePrivate::getV8Engine(&engine);
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(v8);
+    QV4::Scope scope(v4);
+    QV4::ScopedValue value(scope, QV4::Script(v4->rootContext, source).run());
+    QVERIFY(!scope.hasException());
+
+    const QByteArray data = QV4::Serialize::serialize(value, v8);
+    QV4::ScopedValue result(scope);
+    QBENCHMARK {
+        result = QV4::Serialize::deserialize(data, v8);
+    }
+    QVERIFY(result->asArrayObject());
+}
+
+QTEST_MAIN(tst_qv4serialize)
+
+#include "tst_qv4serialize.moc"